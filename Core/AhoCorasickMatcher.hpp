@@ -0,0 +1,329 @@
+//
+// Created on 2026/10/16 at 21:45.
+//
+
+#ifndef DATASTRUCTUREPROJECT_AHOCORASICKMATCHER_HPP
+#define DATASTRUCTUREPROJECT_AHOCORASICKMATCHER_HPP
+
+#include <vector>
+#include <algorithm>
+#include "CharString.hpp"
+#include "CharStringView.hpp"
+
+
+/// \brief Finds the occurrences of a set of patterns in a text in one scan, for highlighting query words.
+/// \note The patterns are compiled to an Aho-Corasick automaton: a trie of the patterns, where each node
+/// links to the node of its longest proper suffix in the trie and to the nearest such suffix that is a pattern.
+/// The edges of each node are sorted by character and stored together, a step binary searches them.
+class AhoCorasickMatcher
+{
+public:
+    class Match
+    {
+    public:
+        int Start;
+        int Length;
+
+        /// \brief Index of the pattern in the list given to the constructor.
+        int Pattern;
+    };
+
+    class Span
+    {
+    public:
+        int Start;
+        int Length;
+    };
+
+    /// \brief Compile some patterns.
+    /// \param patterns The patterns, empty ones are skipped. Of equal patterns, the first one is reported.
+    explicit AhoCorasickMatcher(const std::vector<CharString>& patterns);
+
+    /// \brief Get all the occurrences of the patterns in a text, they may overlap.
+    /// \param text The text to scan.
+    /// \return The occurrences in the order of their ends, the longer one first for the same end.
+    std::vector<Match> FindAll(const CharStringView& text) const;
+
+    /// \brief Get the parts of a text covered by the patterns.
+    /// \param text The text to scan.
+    /// \return The spans in ascending order, overlapping and adjacent occurrences are merged.
+    std::vector<Span> GetHighlights(const CharStringView& text) const;
+
+    /// \brief Get the window of a text best covering the patterns.
+    /// \param text The text to scan.
+    /// \param width The number of characters of the window.
+    /// \return The window with the most distinct patterns fully inside, then the most occurrences.
+    /// The occurrences are centered in it when possible. The start of the text if no pattern occurs.
+    Span GetSnippet(const CharStringView& text, int width) const;
+
+    /// \brief Get the number of distinct patterns compiled.
+    int GetPatternCount() const;
+
+private:
+    class Node
+    {
+    public:
+        /// \brief The edges of the node are <code>_edges[FirstEdge, FirstEdge + EdgeCount)</code>.
+        int FirstEdge = 0;
+        int EdgeCount = 0;
+
+        /// \brief The node of the longest proper suffix, the root is 0.
+        int Failure = 0;
+
+        /// \brief The nearest node on the failure chain that ends a pattern, 0 if none.
+        int Output = 0;
+
+        /// \brief The number of characters from the root.
+        int Depth = 0;
+
+        /// \brief Index of the pattern ending at the node, -1 if none.
+        int Pattern = -1;
+    };
+
+    class Edge
+    {
+    public:
+        wchar_t Character;
+        int Target;
+
+        bool operator<(const Edge& rhs) const
+        {
+            return Character < rhs.Character;
+        }
+    };
+
+    std::vector<Node> _nodes;
+    std::vector<Edge> _edges;
+    int _patternCount = 0;
+
+    /// \brief Follow an edge of a node.
+    /// \return The target node, -1 if there is no such edge.
+    int GetChild(int node, wchar_t character) const;
+};
+
+
+inline AhoCorasickMatcher::AhoCorasickMatcher(const std::vector<CharString>& patterns)
+{
+    // Build the trie with the edges of each node in its own list, they are packed afterwards.
+    std::vector<std::vector<Edge>> children(1);
+    _nodes.emplace_back();
+
+    for (auto pattern = 0; pattern < static_cast<int>(patterns.size()); pattern++)
+    {
+        const auto& word = patterns[pattern];
+        if (word.IsEmpty())
+        {
+            continue;
+        }
+
+        auto node = 0;
+        for (auto i = 0; i < word.GetLength(); i++)
+        {
+            auto& edges = children[node];
+            const auto found = std::find_if(edges.begin(), edges.end(), [&word, i](const Edge& edge)
+            {
+                return edge.Character == word[i];
+            });
+
+            if (found != edges.end())
+            {
+                node = found->Target;
+                continue;
+            }
+
+            const auto child = static_cast<int>(_nodes.size());
+            edges.push_back(Edge{word[i], child});
+            _nodes.emplace_back();
+            _nodes.back().Depth = i + 1;
+            children.emplace_back();
+            node = child;
+        }
+
+        if (_nodes[node].Pattern == -1)
+        {
+            _nodes[node].Pattern = pattern;
+            _patternCount++;
+        }
+    }
+
+    for (auto node = 0; node < static_cast<int>(_nodes.size()); node++)
+    {
+        auto& edges = children[node];
+        std::sort(edges.begin(), edges.end());
+
+        _nodes[node].FirstEdge = static_cast<int>(_edges.size());
+        _nodes[node].EdgeCount = static_cast<int>(edges.size());
+        _edges.insert(_edges.end(), edges.begin(), edges.end());
+    }
+
+    // Link the nodes in breadth-first order, so the suffixes are linked before the nodes using them.
+    std::vector<int> queue(1, 0);
+    for (auto head = 0; head < static_cast<int>(queue.size()); head++)
+    {
+        const auto node = queue[head];
+        for (auto e = _nodes[node].FirstEdge; e < _nodes[node].FirstEdge + _nodes[node].EdgeCount; e++)
+        {
+            const auto character = _edges[e].Character;
+            const auto child = _edges[e].Target;
+            queue.push_back(child);
+
+            if (node == 0)
+            {
+                continue;
+            }
+
+            auto failure = _nodes[node].Failure;
+            while (failure != 0 && GetChild(failure, character) == -1)
+            {
+                failure = _nodes[failure].Failure;
+            }
+
+            const auto target = GetChild(failure, character);
+            _nodes[child].Failure = target == -1 ? 0 : target;
+
+            const auto& suffix = _nodes[_nodes[child].Failure];
+            _nodes[child].Output = suffix.Pattern != -1 ? _nodes[child].Failure : suffix.Output;
+        }
+    }
+}
+
+
+inline std::vector<AhoCorasickMatcher::Match> AhoCorasickMatcher::FindAll(const CharStringView& text) const
+{
+    std::vector<Match> matches;
+
+    auto node = 0;
+    for (auto i = 0; i < text.GetLength(); i++)
+    {
+        const auto character = text[i];
+        auto child = GetChild(node, character);
+        while (child == -1 && node != 0)
+        {
+            node = _nodes[node].Failure;
+            child = GetChild(node, character);
+        }
+
+        node = child == -1 ? 0 : child;
+
+        // The node itself may not end a pattern, but a suffix of it may.
+        for (auto output = _nodes[node].Pattern != -1 ? node : _nodes[node].Output; output != 0;
+             output = _nodes[output].Output)
+        {
+            const auto length = _nodes[output].Depth;
+            matches.push_back(Match{i + 1 - length, length, _nodes[output].Pattern});
+        }
+    }
+
+    return matches;
+}
+
+
+inline std::vector<AhoCorasickMatcher::Span> AhoCorasickMatcher::GetHighlights(const CharStringView& text) const
+{
+    auto matches = FindAll(text);
+    std::sort(matches.begin(), matches.end(), [](const Match& lhs, const Match& rhs)
+    {
+        return lhs.Start < rhs.Start;
+    });
+
+    std::vector<Span> spans;
+    for (const auto& match : matches)
+    {
+        if (!spans.empty() && match.Start <= spans.back().Start + spans.back().Length)
+        {
+            const auto end = std::max(spans.back().Start + spans.back().Length, match.Start + match.Length);
+            spans.back().Length = end - spans.back().Start;
+        }
+        else
+        {
+            spans.push_back(Span{match.Start, match.Length});
+        }
+    }
+
+    return spans;
+}
+
+
+inline AhoCorasickMatcher::Span AhoCorasickMatcher::GetSnippet(const CharStringView& text, const int width) const
+{
+    auto matches = FindAll(text);
+    std::sort(matches.begin(), matches.end(), [](const Match& lhs, const Match& rhs)
+    {
+        return lhs.Start < rhs.Start;
+    });
+
+    auto patternLimit = 0;
+    for (const auto& match : matches)
+    {
+        patternLimit = std::max(patternLimit, match.Pattern + 1);
+    }
+
+    // Try the windows starting at each occurrence. A pattern is counted in a window if its stamp is the window.
+    std::vector<int> stamps(patternLimit, -1);
+    auto bestDistinct = 0;
+    auto bestCount = 0;
+    auto bestStart = 0;
+    auto bestEnd = 0;
+
+    for (auto left = 0; left < static_cast<int>(matches.size()); left++)
+    {
+        const auto windowEnd = matches[left].Start + width;
+        auto distinct = 0;
+        auto count = 0;
+        auto end = matches[left].Start;
+
+        for (auto i = left; i < static_cast<int>(matches.size()) && matches[i].Start < windowEnd; i++)
+        {
+            const auto& match = matches[i];
+            if (match.Start + match.Length > windowEnd)
+            {
+                continue;
+            }
+
+            if (stamps[match.Pattern] != left)
+            {
+                stamps[match.Pattern] = left;
+                distinct++;
+            }
+            count++;
+            end = std::max(end, match.Start + match.Length);
+        }
+
+        if (distinct > bestDistinct || (distinct == bestDistinct && count > bestCount))
+        {
+            bestDistinct = distinct;
+            bestCount = count;
+            bestStart = matches[left].Start;
+            bestEnd = end;
+        }
+    }
+
+    const auto length = std::min(width, text.GetLength());
+    auto start = 0;
+    if (bestCount != 0)
+    {
+        start = std::max(0, bestStart - (width - (bestEnd - bestStart)) / 2);
+        start = std::min(start, text.GetLength() - length);
+    }
+
+    return Span{start, length};
+}
+
+
+inline int AhoCorasickMatcher::GetPatternCount() const
+{
+    return _patternCount;
+}
+
+
+inline int AhoCorasickMatcher::GetChild(const int node, const wchar_t character) const
+{
+    const auto first = _edges.begin() + _nodes[node].FirstEdge;
+    const auto last = first + _nodes[node].EdgeCount;
+    const auto found = std::lower_bound(first, last, Edge{character, 0});
+
+    return found != last && found->Character == character ? found->Target : -1;
+}
+
+
+#endif //DATASTRUCTUREPROJECT_AHOCORASICKMATCHER_HPP
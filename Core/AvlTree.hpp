@@ -7,14 +7,17 @@
 
 #include <algorithm>
 #include <utility>
+#include <type_traits>
 #include "SortedList.hpp"
+#include "NodeAllocator.hpp"
 
 /// \brief A dictionary implemented with AVL tree.
 /// \tparam TKey Type of the key.
 /// \tparam TValue Type of the value, need to have a default constructor.
 /// \tparam TLess A Function returning a boolean value to determine the order of the key,
 /// Will be called like <code>less(key1, key2)</code>, meaning key1 &lt; key2 if it returns true.
-template <typename TKey, typename TValue, typename TLess>
+/// \tparam TAllocator The allocator of the nodes, <code>HeapNodeAllocator</code> or <code>ArenaNodeAllocator</code>.
+template <typename TKey, typename TValue, typename TLess, template <typename> class TAllocator = HeapNodeAllocator>
 class AvlTree
 {
 public:
@@ -49,7 +52,7 @@ public:
     AvlTree(const AvlTree&) = delete;
 
     AvlTree(AvlTree&& rhs) noexcept:
-        _root(rhs._root)
+        _root(rhs._root), _allocator(std::move(rhs._allocator))
     {
         rhs._root = nullptr;
     }
@@ -79,13 +82,6 @@ private:
         }
 
 
-        virtual ~AvlTreeNode()
-        {
-            delete Left;
-            delete Right;
-        }
-
-
         /// \brief Get the height of a node or a null node.
         /// \param node Pointer to the node (or <code>nullptr</code>).
         /// \return The height of the node, or 0 if the node is null.
@@ -118,6 +114,8 @@ private:
 private:
     AvlTreeNode* _root = nullptr;
 
+    TAllocator<AvlTreeNode> _allocator;
+
     /// \brief Rotate the tree if it is not balanced.(Case LL)
     /// \param node Root of the minimal unbalanced tree.
     /// \return New root of the minimal unbalanced tree.
@@ -143,13 +141,13 @@ private:
     /// \param key Key of the record.
     /// \param value Value of the record.
     /// \return New root of the subtree (the root may change because of rotation).
-    static AvlTreeNode* InsertToTree(AvlTreeNode* tree, const TKey& key, const TValue& value);
+    AvlTreeNode* InsertToTree(AvlTreeNode* tree, const TKey& key, const TValue& value);
 
     /// \brief Remove a record from a given subtree.
     /// \param tree The subtree which the record will be removed from.
     /// \param key Key of the record.
     /// \return New root of the subtree (the root may change because of ratation).
-    static AvlTreeNode* RemoveInTree(AvlTreeNode* tree, const TKey& key);
+    AvlTreeNode* RemoveInTree(AvlTreeNode* tree, const TKey& key);
 
 public:
     class ReadWriteIterator
@@ -189,9 +187,12 @@ public:
 
 
     /// \brief Locate the element with given key.
+    /// \tparam TLookupKey Type of the key to look up, <code>TKey</code> or any type <code>TLess</code>
+    /// can compare with <code>TKey</code> in both orders, e.g. <code>CharStringView</code> with <code>std::less<></code>.
     /// \param key Key of the locating element.
     /// \return Iterator to the element, end() if not found.
-    ReadWriteIterator Locate(const TKey& key);
+    template <typename TLookupKey>
+    ReadWriteIterator Locate(const TLookupKey& key);
 
 public:
     class PairLess
@@ -209,14 +210,14 @@ public:
 };
 
 
-template <typename TKey, typename TValue, typename TLess>
-void AvlTree<TKey, TValue, TLess>::Insert(const TKey& key, const TValue& value)
+template <typename TKey, typename TValue, typename TLess, template <typename> class TAllocator>
+void AvlTree<TKey, TValue, TLess, TAllocator>::Insert(const TKey& key, const TValue& value)
 {
     _root = InsertToTree(_root, key, value);
 }
 
-template <typename TKey, typename TValue, typename TLess>
-bool AvlTree<TKey, TValue, TLess>::Contains(const TKey& key)
+template <typename TKey, typename TValue, typename TLess, template <typename> class TAllocator>
+bool AvlTree<TKey, TValue, TLess, TAllocator>::Contains(const TKey& key)
 {
     auto comparing = _root;
     while (true)
@@ -241,8 +242,8 @@ bool AvlTree<TKey, TValue, TLess>::Contains(const TKey& key)
     }
 }
 
-template <typename TKey, typename TValue, typename TLess>
-TValue AvlTree<TKey, TValue, TLess>::Search(const TKey& key)
+template <typename TKey, typename TValue, typename TLess, template <typename> class TAllocator>
+TValue AvlTree<TKey, TValue, TLess, TAllocator>::Search(const TKey& key)
 {
     auto comparing = _root;
     while (true)
@@ -268,14 +269,14 @@ TValue AvlTree<TKey, TValue, TLess>::Search(const TKey& key)
 }
 
 
-template <typename TKey, typename TValue, typename TLess>
-void AvlTree<TKey, TValue, TLess>::Remove(const TKey& key)
+template <typename TKey, typename TValue, typename TLess, template <typename> class TAllocator>
+void AvlTree<TKey, TValue, TLess, TAllocator>::Remove(const TKey& key)
 {
     _root = RemoveInTree(_root, key);
 }
 
-template <typename TKey, typename TValue, typename TLess>
-void AvlTree<TKey, TValue, TLess>::InorderTraversal(
+template <typename TKey, typename TValue, typename TLess, template <typename> class TAllocator>
+void AvlTree<TKey, TValue, TLess, TAllocator>::InorderTraversal(
     const std::function<void(const TKey&, const TValue&)>& traversalFunction)
 {
     if (_root != nullptr)
@@ -284,15 +285,39 @@ void AvlTree<TKey, TValue, TLess>::InorderTraversal(
     }
 }
 
-template <typename TKey, typename TValue, typename TLess>
-AvlTree<TKey, TValue, TLess>::~AvlTree()
+template <typename TKey, typename TValue, typename TLess, template <typename> class TAllocator>
+AvlTree<TKey, TValue, TLess, TAllocator>::~AvlTree()
 {
-    delete _root;
+    // The arena frees the nodes at once, only the records may need to be destroyed one by one.
+    if (TAllocator<AvlTreeNode>::ReleasesAll &&
+        std::is_trivially_destructible<TKey>::value && std::is_trivially_destructible<TValue>::value)
+    {
+        return;
+    }
+
+    // Rotate the left children up until the root has none, then the root can go without a stack.
+    while (_root != nullptr)
+    {
+        if (_root->Left != nullptr)
+        {
+            auto left = _root->Left;
+            _root->Left = left->Right;
+            left->Right = _root;
+            _root = left;
+        }
+        else
+        {
+            auto right = _root->Right;
+            _allocator.Destroy(_root);
+            _root = right;
+        }
+    }
 }
 
 
-template <typename TKey, typename TValue, typename TLess>
-typename AvlTree<TKey, TValue, TLess>::AvlTreeNode* AvlTree<TKey, TValue, TLess>::RotateLeftLeft(AvlTreeNode* node)
+template <typename TKey, typename TValue, typename TLess, template <typename> class TAllocator>
+typename AvlTree<TKey, TValue, TLess, TAllocator>::AvlTreeNode*
+AvlTree<TKey, TValue, TLess, TAllocator>::RotateLeftLeft(AvlTreeNode* node)
 {
     auto newRoot = node->Left;
     node->Left = newRoot->Right;
@@ -306,8 +331,9 @@ typename AvlTree<TKey, TValue, TLess>::AvlTreeNode* AvlTree<TKey, TValue, TLess>
 }
 
 
-template <typename TKey, typename TValue, typename TLess>
-typename AvlTree<TKey, TValue, TLess>::AvlTreeNode* AvlTree<TKey, TValue, TLess>::RotateRightRight(AvlTreeNode* node)
+template <typename TKey, typename TValue, typename TLess, template <typename> class TAllocator>
+typename AvlTree<TKey, TValue, TLess, TAllocator>::AvlTreeNode*
+AvlTree<TKey, TValue, TLess, TAllocator>::RotateRightRight(AvlTreeNode* node)
 {
     auto newRoot = node->Right;
     node->Right = newRoot->Left;
@@ -321,29 +347,31 @@ typename AvlTree<TKey, TValue, TLess>::AvlTreeNode* AvlTree<TKey, TValue, TLess>
 }
 
 
-template <typename TKey, typename TValue, typename TLess>
-typename AvlTree<TKey, TValue, TLess>::AvlTreeNode* AvlTree<TKey, TValue, TLess>::RotateLeftRight(AvlTreeNode* node)
+template <typename TKey, typename TValue, typename TLess, template <typename> class TAllocator>
+typename AvlTree<TKey, TValue, TLess, TAllocator>::AvlTreeNode*
+AvlTree<TKey, TValue, TLess, TAllocator>::RotateLeftRight(AvlTreeNode* node)
 {
     node->Left = RotateRightRight(node->Left);
     return RotateLeftLeft(node);
 }
 
 
-template <typename TKey, typename TValue, typename TLess>
-typename AvlTree<TKey, TValue, TLess>::AvlTreeNode* AvlTree<TKey, TValue, TLess>::RotateRightLeft(AvlTreeNode* node)
+template <typename TKey, typename TValue, typename TLess, template <typename> class TAllocator>
+typename AvlTree<TKey, TValue, TLess, TAllocator>::AvlTreeNode*
+AvlTree<TKey, TValue, TLess, TAllocator>::RotateRightLeft(AvlTreeNode* node)
 {
     node->Right = RotateLeftLeft(node->Right);
     return RotateRightRight(node);
 }
 
 
-template <typename TKey, typename TValue, typename TLess>
-typename AvlTree<TKey, TValue, TLess>::AvlTreeNode*
-AvlTree<TKey, TValue, TLess>::InsertToTree(AvlTreeNode* tree, const TKey& key, const TValue& value)
+template <typename TKey, typename TValue, typename TLess, template <typename> class TAllocator>
+typename AvlTree<TKey, TValue, TLess, TAllocator>::AvlTreeNode*
+AvlTree<TKey, TValue, TLess, TAllocator>::InsertToTree(AvlTreeNode* tree, const TKey& key, const TValue& value)
 {
     if (tree == nullptr)
     {
-        tree = new AvlTreeNode(key, value);
+        tree = _allocator.Create(key, value);
     }
     else if (TLess()(key, tree->Key))
     {
@@ -386,9 +414,9 @@ AvlTree<TKey, TValue, TLess>::InsertToTree(AvlTreeNode* tree, const TKey& key, c
     return tree;
 }
 
-template <typename TKey, typename TValue, typename TLess>
-typename AvlTree<TKey, TValue, TLess>::AvlTreeNode*
-AvlTree<TKey, TValue, TLess>::RemoveInTree(AvlTreeNode* tree, const TKey& key)
+template <typename TKey, typename TValue, typename TLess, template <typename> class TAllocator>
+typename AvlTree<TKey, TValue, TLess, TAllocator>::AvlTreeNode*
+AvlTree<TKey, TValue, TLess, TAllocator>::RemoveInTree(AvlTreeNode* tree, const TKey& key)
 {
     if (tree == nullptr)
     {
@@ -468,17 +496,22 @@ AvlTree<TKey, TValue, TLess>::RemoveInTree(AvlTreeNode* tree, const TKey& key)
         {
             auto temp = tree;
             tree = (tree->Left == nullptr ? tree->Right : tree->Left);
-            temp->Left = nullptr;
-            temp->Right = nullptr;
-            delete temp;
+            _allocator.Destroy(temp);
         }
     }
 
+    if (tree != nullptr)
+    {
+        tree->Height = std::max(AvlTreeNode::GetHeight(tree->Left), AvlTreeNode::GetHeight(tree->Right)) + 1;
+    }
+
     return tree;
 }
 
-template <typename TKey, typename TValue, typename TLess>
-typename AvlTree<TKey, TValue, TLess>::ReadWriteIterator AvlTree<TKey, TValue, TLess>::Locate(const TKey& key)
+template <typename TKey, typename TValue, typename TLess, template <typename> class TAllocator>
+template <typename TLookupKey>
+typename AvlTree<TKey, TValue, TLess, TAllocator>::ReadWriteIterator
+AvlTree<TKey, TValue, TLess, TAllocator>::Locate(const TLookupKey& key)
 {
     auto comparing = _root;
     while (true)
@@ -503,11 +536,11 @@ typename AvlTree<TKey, TValue, TLess>::ReadWriteIterator AvlTree<TKey, TValue, T
     }
 }
 
-template <typename TKey, typename TValue, typename TLess>
-SortedList<std::pair<TKey, TValue>, typename AvlTree<TKey, TValue, TLess>::PairLess>
-AvlTree<TKey, TValue, TLess>::ToSortedList()
+template <typename TKey, typename TValue, typename TLess, template <typename> class TAllocator>
+SortedList<std::pair<TKey, TValue>, typename AvlTree<TKey, TValue, TLess, TAllocator>::PairLess>
+AvlTree<TKey, TValue, TLess, TAllocator>::ToSortedList()
 {
-    SortedList<std::pair<TKey, TValue>, typename AvlTree<TKey, TValue, TLess>::PairLess> ret;
+    SortedList<std::pair<TKey, TValue>, PairLess> ret;
     InorderTraversal(
         [&ret](const TKey& key,const TValue& value) -> void
         {
@@ -7,7 +7,11 @@
 
 #include "AvlTree.hpp"
 #include "CharStringList.hpp"
+#include "Utf8String.hpp"
+#include "TermTable.hpp"
 #include "InvertedIndexNode.hpp"
+#include "DocumentStatistics.hpp"
+#include "TopKQueryEngine.hpp"
 
 class SortBySecond
 {
@@ -21,23 +25,47 @@ public:
 class AvlTreeInvertedIndex
 {
 public:
-    AvlTree<CharString, InvertedIndexNode, std::less<CharString>> Core;
+    /// \brief The indexed words, keyed by their term ids in <code>TermTable::GetGlobal()</code>.
+    AvlTree<std::uint32_t, InvertedIndexNode, std::less<std::uint32_t>> Core;
+
+    /// \brief Lengths of the indexed documents.
+    DocumentStatistics Documents;
+
+    /// \brief Index all the words of a document from its term frequency table,
+    /// and record its length, used by <code>QueryTopK</code>.
+    /// \param document The document, each document should only be added once.
+    void AddDocument(const Document* document);
 
     /// \note If the word is not indexed, it will be created automatically.
-    void AddOccurrence(const CharString& word, Document* document, int times);
+    void AddOccurrence(std::uint32_t termId, const Document* document, int times);
+
+    /// \brief Merge another index built over a disjoint set of documents into the instance.
+    /// \param rhs The index to merge from. It is not modified.
+    void Merge(AvlTreeInvertedIndex& rhs);
+
+    /// \brief Call a function on each indexed word and its node, in ascending order of term id.
+    /// \param visitFunction The function to be called on each word.
+    void Iterate(const std::function<void(const Utf8String&, const InvertedIndexNode&)>& visitFunction);
+
+    /// \brief Get the best k documents for the query, ranked by BM25.
+    /// \param queryList The words in the query, they are looked up in the term table once.
+    /// \param k The number of documents to return.
+    /// \return Pairs of document id and score, in descending order of score.
+    LinkedList<std::pair<int, double>> QueryTopK(const CharStringList& queryList, int k);
 
     LinkedList<std::pair<int, int>> Query(const CharStringList& queryList);
 };
 
-inline void AvlTreeInvertedIndex::AddOccurrence(const CharString& word, Document* document, const int times)
+inline void AvlTreeInvertedIndex::AddOccurrence(const std::uint32_t termId, const Document* document,
+                                                const int times)
 {
-    auto location = Core.Locate(word);
+    auto location = Core.Locate(termId);
 
     if (location == Core.end())
     {
-        InvertedIndexNode insertingNode(word);
+        InvertedIndexNode insertingNode(termId);
         insertingNode.AddOccurrence(document, times);
-        Core.Insert(word, insertingNode);
+        Core.Insert(termId, insertingNode);
     }
     else
     {
@@ -45,22 +73,67 @@ inline void AvlTreeInvertedIndex::AddOccurrence(const CharString& word, Document
     }
 }
 
+inline void AvlTreeInvertedIndex::AddDocument(const Document* document)
+{
+    Documents.Add(document->Id, static_cast<int>(document->Words.size()));
+
+    for (const auto& item : document->GetTermFrequencies())
+    {
+        AddOccurrence(item.first, document, item.second);
+    }
+}
+
+inline void AvlTreeInvertedIndex::Iterate(
+    const std::function<void(const Utf8String&, const InvertedIndexNode&)>& visitFunction)
+{
+    const auto& terms = TermTable::GetGlobal();
+    Core.InorderTraversal([&terms, &visitFunction](const std::uint32_t& termId, const InvertedIndexNode& node)-> void
+    {
+        visitFunction(terms.GetWord(termId), node);
+    });
+}
+
+inline void AvlTreeInvertedIndex::Merge(AvlTreeInvertedIndex& rhs)
+{
+    Documents.Merge(rhs.Documents);
+
+    rhs.Core.InorderTraversal([this](const std::uint32_t& termId, const InvertedIndexNode& node)-> void
+    {
+        auto location = Core.Locate(termId);
+
+        if (location == Core.end())
+        {
+            Core.Insert(termId, node);
+        }
+        else
+        {
+            location->Merge(node);
+        }
+    });
+}
+
 inline LinkedList<std::pair<int, int>> AvlTreeInvertedIndex::Query(const CharStringList& queryList)
 {
-    AvlTree<int, int, std::less<int>> results;
-    AvlTree<int, int, std::less<int>> documentRichness;
+    AvlTree<int, int, std::less<int>, ArenaNodeAllocator> results;
+    AvlTree<int, int, std::less<int>, ArenaNodeAllocator> documentRichness;
+    const auto& terms = TermTable::GetGlobal();
 
     for (const auto& item : queryList)
     {
-        auto location = Core.Locate(item);
+        std::uint32_t termId;
+        if (!terms.Find(item, termId))
+        {
+            continue;
+        }
+
+        auto location = Core.Locate(termId);
 
         if (location != Core.end())
         {
             for (const auto& documentOccurence : location->DocumentOccurrenceList)
             {
-                auto done = false;
-                auto documentId = documentOccurence.first->Id;
-                auto occurrence = documentOccurence.second;
+                auto documentId = documentOccurence.DocumentId;
+                auto occurrence = documentOccurence.Frequency;
 
                 auto idLocation = results.Locate(documentId);
 
@@ -86,7 +159,7 @@ inline LinkedList<std::pair<int, int>> AvlTreeInvertedIndex::Query(const CharStr
         }
     }
 
-    SortedList<std::pair<int, int>, SortBySecond> sortedResult;
+    SortedList<std::pair<int, int>, SortBySecond, ArenaNodeAllocator> sortedResult;
 
     const std::function<void(const int&, const int&)> iterationFunction =
         [&sortedResult](const int& id,const int& richness)-> void
@@ -106,4 +179,36 @@ inline LinkedList<std::pair<int, int>> AvlTreeInvertedIndex::Query(const CharStr
 }
 
 
+inline LinkedList<std::pair<int, double>> AvlTreeInvertedIndex::QueryTopK(const CharStringList& queryList, const int k)
+{
+    std::vector<TermCursor> cursors;
+    std::vector<const InvertedIndexNode*> visited;
+    const auto& terms = TermTable::GetGlobal();
+
+    for (const auto& item : queryList)
+    {
+        std::uint32_t termId;
+        if (!terms.Find(item, termId))
+        {
+            continue;
+        }
+
+        auto location = Core.Locate(termId);
+
+        if (location != Core.end())
+        {
+            const InvertedIndexNode* node = &(*location);
+
+            // Repeated words in the query are scored once.
+            if (std::find(visited.begin(), visited.end(), node) == visited.end())
+            {
+                visited.push_back(node);
+                cursors.push_back(TermCursor(node->DocumentOccurrenceList));
+            }
+        }
+    }
+
+    return TopKQueryEngine::Query(cursors, Documents, k);
+}
+
 #endif //DATASTRUCTUREPROJECT_AVLTREEINVERTEDINDEX_HPP
@@ -0,0 +1,321 @@
+//
+// Created on 2026/10/16 at 20:55.
+//
+
+#ifndef DATASTRUCTUREPROJECT_BENCHMARK_HPP
+#define DATASTRUCTUREPROJECT_BENCHMARK_HPP
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <omp.h>
+#include "CharStringView.hpp"
+#include "Transcoder.hpp"
+#include "HtmlTokenizer.hpp"
+#include "Dictionary.hpp"
+
+
+/// \brief Measurements run from the command line with <code>--benchmark</code>, the results are printed.
+class Benchmark
+{
+public:
+    /// \brief Report how the words of some dictionaries collide in hash tables,
+    /// with the current hash code of <code>CharString</code> and the one it replaced.
+    /// \param dictionaryPaths Paths to the dictionaries, in GBK, one word per line.
+    /// \note Each dictionary is measured alone and then all of them together. For each hash and table size,
+    /// the rate is the share of the words falling in a bucket already taken by another word.
+    static void ReportHashCollisions(const std::vector<std::string>& dictionaryPaths);
+
+    /// \brief Report the time of testing the inline tags on the start tags of a page,
+    /// and the stop words on its characters, with the current tables and the comparisons they replaced.
+    /// \param html Content of the page.
+    static void ReportLookups(const std::wstring& html);
+
+private:
+    /// \brief The hash code of <code>CharString</code> before it had 64 bits, in [0, 100019).
+    static unsigned int ComputeLegacyHashCode(const wchar_t* data, int length);
+
+    /// \brief Print the collision rates of a set of distinct words.
+    static void ReportHashCollisions(const std::string& name, const std::vector<std::wstring>& words);
+
+    /// \brief Get the share of the codes falling in a bucket already taken.
+    /// \param codes The hash codes, one for each distinct word.
+    /// \param bucketCount The number of buckets, a code goes to the bucket <code>code % bucketCount</code>.
+    /// 0 to compare the full codes.
+    static double GetCollisionRate(const std::vector<std::uint64_t>& codes, std::uint64_t bucketCount);
+
+    static const int LegacyHashRange = 100019;
+
+    /// \brief The test of inline tags before the perfect hash table, one comparison for each tag.
+    static bool IsLegacyInlineTag(const CharStringView& tag);
+
+    /// \brief The test of stop words before the bitmap, one comparison for each character.
+    static bool IsLegacyStopWord(wchar_t word);
+
+    /// \brief Handler of <code>HtmlTokenizer</code> collecting the names of the start tags.
+    class TagCollector
+    {
+    public:
+        std::vector<CharStringView> Names;
+
+        void OnStartElement(const CharStringView& name, const std::vector<CharStringView>&)
+        {
+            Names.push_back(name);
+        }
+
+        void OnEndElement(const CharStringView&)
+        {
+        }
+
+        void OnText(const CharStringView&)
+        {
+        }
+
+        void OnComment(const CharStringView&)
+        {
+        }
+    };
+};
+
+
+inline void Benchmark::ReportHashCollisions(const std::vector<std::string>& dictionaryPaths)
+{
+    std::vector<std::wstring> allWords;
+    for (const auto& path : dictionaryPaths)
+    {
+        auto words = Transcoder::ReadLines(path, Transcoder::Encoding::Gb18030);
+        words.erase(std::remove(words.begin(), words.end(), std::wstring()), words.end());
+
+        allWords.insert(allWords.end(), words.begin(), words.end());
+        ReportHashCollisions(path, words);
+    }
+
+    if (dictionaryPaths.size() > 1)
+    {
+        ReportHashCollisions("all dictionaries", allWords);
+    }
+}
+
+
+inline unsigned int Benchmark::ComputeLegacyHashCode(const wchar_t* data, const int length)
+{
+    auto sum = 0u;
+    for (auto i = 0; i < length; i++)
+    {
+        sum += sum * 7 + data[i];
+    }
+
+    return sum % LegacyHashRange;
+}
+
+
+inline void Benchmark::ReportHashCollisions(const std::string& name, const std::vector<std::wstring>& words)
+{
+    auto distinctWords = words;
+    std::sort(distinctWords.begin(), distinctWords.end());
+    distinctWords.erase(std::unique(distinctWords.begin(), distinctWords.end()), distinctWords.end());
+
+    const auto count = static_cast<int>(distinctWords.size());
+    if (count == 0)
+    {
+        std::cout << name << ": no words.\n";
+        return;
+    }
+
+    // Hash all the words a few times, so the time is long enough to measure.
+    const auto rounds = std::max(1, 4000000 / count);
+    std::vector<std::uint64_t> legacyCodes(count);
+    std::vector<std::uint64_t> codes(count);
+
+    auto start = omp_get_wtime();
+    for (auto round = 0; round < rounds; round++)
+    {
+        for (auto i = 0; i < count; i++)
+        {
+            const auto& word = distinctWords[i];
+            legacyCodes[i] = ComputeLegacyHashCode(word.data(), static_cast<int>(word.size()));
+        }
+    }
+    const auto legacyTime = (omp_get_wtime() - start) / rounds / count * 1e9;
+
+    start = omp_get_wtime();
+    for (auto round = 0; round < rounds; round++)
+    {
+        for (auto i = 0; i < count; i++)
+        {
+            const auto& word = distinctWords[i];
+            codes[i] = CharStringView::ComputeHashCode(word.data(), static_cast<int>(word.size()));
+        }
+    }
+    const auto time = (omp_get_wtime() - start) / rounds / count * 1e9;
+
+    // The smallest power of two holding all the words, as the flat hash map would allocate.
+    std::uint64_t powerOfTwo = 1;
+    while (powerOfTwo < static_cast<std::uint64_t>(count))
+    {
+        powerOfTwo *= 2;
+    }
+
+    std::cout << name << ": " << count << " distinct words.\n" << std::fixed << std::setprecision(2);
+    for (const auto bucketCount : {static_cast<std::uint64_t>(LegacyHashRange), powerOfTwo, powerOfTwo * 2})
+    {
+        // What a uniformly random hash would give: the words minus the expected number of taken buckets.
+        const auto expectedTaken = bucketCount * (1 - std::pow(1 - 1.0 / bucketCount, count));
+        const auto expectedRate = (count - expectedTaken) / count;
+
+        std::cout << "  " << std::setw(7) << bucketCount << " buckets: legacy "
+            << std::setw(6) << GetCollisionRate(legacyCodes, bucketCount) * 100 << "%, 64-bit "
+            << std::setw(6) << GetCollisionRate(codes, bucketCount) * 100 << "%, random "
+            << std::setw(6) << expectedRate * 100 << "%\n";
+    }
+
+    std::cout << "  full codes: legacy " << GetCollisionRate(legacyCodes, 0) * 100 << "%, 64-bit "
+        << GetCollisionRate(codes, 0) * 100 << "%\n"
+        << "  hashing: legacy " << legacyTime << " ns, 64-bit " << time << " ns per word\n";
+}
+
+
+inline double Benchmark::GetCollisionRate(const std::vector<std::uint64_t>& codes, const std::uint64_t bucketCount)
+{
+    // Sort the buckets so the words sharing one are adjacent.
+    std::vector<std::uint64_t> buckets;
+    buckets.reserve(codes.size());
+    for (const auto code : codes)
+    {
+        buckets.push_back(bucketCount == 0 ? code : code % bucketCount);
+    }
+
+    std::sort(buckets.begin(), buckets.end());
+    const auto taken = std::unique(buckets.begin(), buckets.end()) - buckets.begin();
+
+    return static_cast<double>(codes.size() - taken) / codes.size();
+}
+
+
+inline void Benchmark::ReportLookups(const std::wstring& html)
+{
+    const CharString page(html);
+    TagCollector collector;
+    HtmlTokenizer::Tokenize(page, collector);
+
+    const auto& names = collector.Names;
+    const auto length = page.GetLength();
+    if (names.empty() || length == 0)
+    {
+        std::cout << "The page is empty.\n";
+        return;
+    }
+
+    // Test all the tags and characters a few times, so the time is long enough to measure.
+    // The counts are printed, so the tests are not optimized away and the results can be compared.
+    const auto tagRounds = std::max(1, 4000000 / static_cast<int>(names.size()));
+    auto legacyInlineCount = 0;
+    auto start = omp_get_wtime();
+    for (auto round = 0; round < tagRounds; round++)
+    {
+        for (const auto& name : names)
+        {
+            legacyInlineCount += IsLegacyInlineTag(name);
+        }
+    }
+    const auto legacyTagTime = (omp_get_wtime() - start) / tagRounds / names.size() * 1e9;
+
+    auto inlineCount = 0;
+    start = omp_get_wtime();
+    for (auto round = 0; round < tagRounds; round++)
+    {
+        for (const auto& name : names)
+        {
+            inlineCount += HtmlTokenizer::IsInlineTag(name);
+        }
+    }
+    const auto tagTime = (omp_get_wtime() - start) / tagRounds / names.size() * 1e9;
+
+    const auto characterRounds = std::max(1, 40000000 / length);
+    auto legacyStopCount = 0;
+    start = omp_get_wtime();
+    for (auto round = 0; round < characterRounds; round++)
+    {
+        for (auto i = 0; i < length; i++)
+        {
+            legacyStopCount += IsLegacyStopWord(page[i]);
+        }
+    }
+    const auto legacyCharacterTime = (omp_get_wtime() - start) / characterRounds / length * 1e9;
+
+    auto stopCount = 0;
+    start = omp_get_wtime();
+    for (auto round = 0; round < characterRounds; round++)
+    {
+        for (auto i = 0; i < length; i++)
+        {
+            stopCount += Dictionary::IsStopWord(page[i]);
+        }
+    }
+    const auto characterTime = (omp_get_wtime() - start) / characterRounds / length * 1e9;
+
+    std::cout << std::fixed << std::setprecision(2)
+        << "inline tags: " << names.size() << " start tags, " << inlineCount / tagRounds << " inline (legacy "
+        << legacyInlineCount / tagRounds << "), legacy " << legacyTagTime << " ns, table " << tagTime
+        << " ns per tag\n"
+        << "stop words: " << length << " characters, " << stopCount / characterRounds << " stop words (legacy "
+        << legacyStopCount / characterRounds << "), legacy " << legacyCharacterTime << " ns, table "
+        << characterTime << " ns per character\n";
+}
+
+
+inline bool Benchmark::IsLegacyInlineTag(const CharStringView& tag)
+{
+    const wchar_t* tags[] = {
+        L"area", L"base", L"br", L"col", L"command", L"embed", L"hr", L"img",
+        L"input", L"keygen", L"link", L"meta", L"param", L"source", L"track", L"wbr"
+    };
+
+    for (const auto inlineTag : tags)
+    {
+        if (tag == CharStringView(inlineTag))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+inline bool Benchmark::IsLegacyStopWord(const wchar_t word)
+{
+    return
+        word == L' ' || word == L'\0' || word == L'\n' || word == L'\t' ||
+        word == L'`' || word == L'~' || word == L'!' || word == L'@' || word == L'#' ||
+        word == L'$' || word == L'%' || word == L'^' || word == L'&' || word == L'*' ||
+        word == L'(' || word == L')' || word == L'-' || word == L'=' || word == L'_' ||
+        word == L'+' || word == L'[' || word == L']' || word == L'\\' || word == L'{' ||
+        word == L'}' || word == L'|' || word == L';' || word == L'\'' || word == L':' ||
+        word == L'"' || word == L',' || word == L'.' || word == L'/' || word == L'<' ||
+        word == L'>' || word == L'?' || word == 0xb7 || word == 0xff01 || word == 0xffe5 ||
+        word == 0x2026 || word == 0xff08 || word == 0xff09 || word == 0x2014 || word == 0x3010 ||
+        word == 0x3011 || word == 0x3001 || word == 0xff1b || word == 0xff1a || word == 0x2018 ||
+        word == 0x2019 || word == 0x201c || word == 0x201d || word == 0xff0c || word == 0x3002 ||
+        word == 0x300a || word == 0x300b || word == L'/' || word == 0xff1f || word == L'q' ||
+        word == L'w' || word == L'e' || word == L'r' || word == L't' || word == L'y' ||
+        word == L'u' || word == L'i' || word == L'o' || word == L'p' || word == L'a' ||
+        word == L's' || word == L'd' || word == L'f' || word == L'g' || word == L'h' ||
+        word == L'j' || word == L'k' || word == L'l' || word == L'z' || word == L'x' ||
+        word == L'c' || word == L'v' || word == L'b' || word == L'n' || word == L'm' ||
+        word == L'Q' || word == L'W' || word == L'E' || word == L'R' || word == L'T' ||
+        word == L'Y' || word == L'U' || word == L'I' || word == L'O' || word == L'P' ||
+        word == L'A' || word == L'S' || word == L'D' || word == L'F' || word == L'G' ||
+        word == L'H' || word == L'J' || word == L'K' || word == L'L' || word == L'Z' ||
+        word == L'X' || word == L'C' || word == L'V' || word == L'B' || word == L'N' ||
+        word == L'M' || word == L'1' || word == L'2' || word == L'3' || word == L'4' ||
+        word == L'5' || word == L'6' || word == L'7' || word == L'8' || word == L'9' ||
+        word == L'0' || word == 160;
+}
+
+
+#endif //DATASTRUCTUREPROJECT_BENCHMARK_HPP
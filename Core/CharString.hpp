@@ -6,18 +6,30 @@
 #define DATASTRUCTUREPROJECT_CHARSTRING_HPP
 
 #include <string>
+#include <vector>
+#include <cstdint>
 #include <stdexcept>
 #include <algorithm>
+#include "CharStringView.hpp"
 
 /// \brief A string of <code>wchar_t</code>.
+/// \note Strings of at most <code>InlineCapacity</code> characters are stored in the instance itself,
+/// only longer ones are allocated on the heap.
 class CharString
 {
 public:
     /// \brief Get the index of the first occurrence of the target string in the instance.
     /// \param targetString The string to locate in the instance.
     /// \return The index of the first occurrence, -1 if the <code>targetString</code> not found.
-    /// \throw std::logic_error if the instance represents an empty string.
-    int IndexOf(const CharString& targetString) const;
+    /// \throw std::logic_error if <code>targetString</code> is empty.
+    /// \note See <code>CharStringView::IndexOf</code>.
+    int IndexOf(const CharStringView& targetString) const;
+
+    /// \brief Get the indexes of all the occurrences of the target string in the instance.
+    /// \param targetString The string to locate in the instance.
+    /// \return The indexes in ascending order, the occurrences do not overlap.
+    /// \throw std::logic_error if <code>targetString</code> is empty.
+    std::vector<int> FindAll(const CharStringView& targetString) const;
 
     /// \brief Get the substring in the instance.
     /// \param left Starting character position of the substring in the instance.
@@ -26,6 +38,14 @@ public:
     /// \throw std::out_of_range if the indexes are invalid.
     CharString GetSubstring(int left, int right) const;
 
+    /// \brief Get the view of a part of the instance, nothing is copied.
+    /// \param left Starting character position of the subview in the instance.
+    /// \param right Ending character position of the subview in the instance.
+    /// \return The view of characters indexed with [<code>left</code>,<code>right</code>) in the instance.
+    /// It is invalidated when the instance is modified or destroyed.
+    /// \throw std::out_of_range if the indexes are invalid.
+    CharStringView GetSubview(int left, int right) const;
+
     /// \brief Concatenate another string to the end of the instance.
     /// \param rhs The string to concatenate.
     void Concat(const CharString& rhs);
@@ -34,14 +54,25 @@ public:
     /// \param rhs The assigning string.
     void Assign(const CharString& rhs);
 
+    /// \brief Assign the instance from a view, the characters are copied.
+    /// \param rhs The assigning view, it can be a view of the instance.
+    void Assign(const CharStringView& rhs);
+
     /// \brief Assign the instance.
     /// \param rhs The assigning string.
     /// \return Reference to the newly assigned string.
     CharString& operator=(const CharString& rhs);
 
-    /// \brief Get the hash code of the instance. The hash code will be in [0, 100018].
+    /// \brief Assign the instance by taking over the content of another one, leaving it empty.
+    /// \param rhs The assigning string.
+    /// \return Reference to the newly assigned string.
+    /// \note The heap buffer and the hash code are taken over, nothing is copied unless the string is inline.
+    CharString& operator=(CharString&& rhs) noexcept;
+
+    /// \brief Get the hash code of the instance, see <code>CharStringView::ComputeHashCode</code>.
     /// \return The hash code of the instance.
-    unsigned int GetHashCode() const;
+    /// \note It is computed whenever the content changes, so it can be read by several threads at once.
+    std::uint64_t GetHashCode() const;
 
     /// \brief Assign the instance from a std::wstring.
     /// \param rhs The assigning std::wstring.
@@ -51,6 +82,10 @@ public:
     /// \return The translated std::wstring.
     std::wstring ToStdWstring() const;
 
+    /// \brief View the whole instance.
+    /// \return The view of all the characters, invalidated when the instance is modified or destroyed.
+    operator CharStringView() const;
+
     /// \brief Compare if two instances are equal.
     /// \param rhs The instance to be compared with.
     /// \return True if their content are the same, otherwise false.
@@ -79,7 +114,7 @@ public:
     /// \return The length of the string in the instance.
     int GetLength() const;
 
-    virtual ~CharString();
+    ~CharString();
 
     /// \brief Test if the character is a white-space character.
     /// \param character The character to be tested.
@@ -91,143 +126,97 @@ public:
     CharString(const CharString& rhs);
     CharString(CharString&& rhs) noexcept;
     explicit CharString(const std::wstring& rhs);
+    explicit CharString(const CharStringView& rhs);
 
     /// \brief Replace all the specific characters in the instance to another one.
     /// \param from The replaced character.
     /// \param to The replacing character.
     void Replace(wchar_t from, wchar_t to);
+
+    /// \brief The most characters stored without allocating, 20 bytes, which fill the instance up to 40 bytes.
+    /// \note The 64-bit hash code makes the instance 8 bytes larger than the 32 it had with a 32-bit code.
+    /// It is kept because <code>FlatHashMap</code> and <code>TermTable</code> use all 64 bits, and the alignment
+    /// of the code leaves 4 bytes that would only be padding, so they hold characters.
+    static const int InlineCapacity = 20 / sizeof(wchar_t);
 private:
-    /// \brief Pointer to the raw data.
-    wchar_t* _data = nullptr;
+    /// \brief Pointer to the raw data, either <code>_inline</code> or a buffer on the heap.
+    wchar_t* _data = _inline;
+
+    /// \brief The cached hash code.
+    std::uint64_t _hashCode = CharStringView::ComputeHashCode(nullptr, 0);
 
     /// \brief The cached length.
     int _length = 0;
 
-    /// \brief The cached hash code.
-    unsigned int _hashCode = 0;
+    /// \brief The storage of short strings.
+    wchar_t _inline[InlineCapacity];
+
+    /// \brief Replace the content of the instance with some characters.
+    /// \param data Pointer to the characters, they can be in the instance.
+    /// \param length The number of characters.
+    void SetContent(const wchar_t* data, int length);
+
+    /// \brief Take over the content of another instance and leave it empty.
+    /// \note The instance must hold no heap buffer.
+    void TakeOver(CharString& rhs);
 
-    /// \brief Update the hash code of the instance.
+    /// \brief Replace the content of the instance with a heap buffer, which the instance then owns.
+    /// \param buffer The buffer allocated with <code>new[]</code>, it may be longer than the content or nullptr.
+    /// \param length The number of characters in the buffer.
+    /// \note Short strings are copied inline and the buffer is released.
+    void Adopt(wchar_t* buffer, int length);
+
+    /// \brief Test if the characters are stored in the instance.
+    bool IsInline() const;
+
+    /// \brief Compute the hash code of the content again.
     /// \note Call this method when the content of the instance changed.
     void UpdateHashCode();
 
+    friend class StringBuilder;
+
 public:
     class Hasher
     {
     public:
-        int operator()(const CharString& charString) const
+        std::uint64_t operator()(const CharString& charString) const
         {
             return charString.GetHashCode();
         }
-    };
-
-    static const int HashMin = 0;
-    static const int HashMax = 100019;
-};
-
-
-int CharString::IndexOf(const CharString& targetString) const
-{
-    // Calculate Next[j].
-    if (targetString._length == 0)
-    {
-        throw std::logic_error("Target string is Empty in CharString::IndexOf()");
-    }
-
-    auto next = new int[targetString._length];
-    next[0] = -1;
-
-    for (auto i = 1; i < targetString._length; i++)
-    {
-        if (next[i - 1] == -1)
-        {
-            next[i] = 0;
-        }
-        else
-        {
-            auto matching = targetString._data[i - 1];
-            auto nextIndex = next[i - 1];
-
-            while (matching != targetString._data[nextIndex])
-            {
-                nextIndex = next[nextIndex];
-                if (nextIndex == -1)
-                {
-                    next[i] = 0;
-                    break;
-                }
-            }
-
-            next[i] = nextIndex + 1;
-        }
-    }
 
-    // Optimize Next[j].
-    for (auto i = 1; i < targetString._length; i++)
-    {
-        if (targetString._data[i] == targetString._data[next[i]])
+        std::uint64_t operator()(const CharStringView& charStringView) const
         {
-            next[i] = next[next[i]];
+            return charStringView.GetHashCode();
         }
-    }
+    };
+};
 
-    // Start matching.
-    auto i = 0;
-    auto j = 0;
 
-    while (true)
-    {
-        while (_data[i] == targetString._data[j])
-        {
-            i++;
-            j++;
+int CharString::IndexOf(const CharStringView& targetString) const
+{
+    return CharStringView(_data, _length).IndexOf(targetString);
+}
 
-            if (j == targetString._length)
-            {
-                delete[] next;
 
-                return i - targetString._length;
-            }
-        }
+std::vector<int> CharString::FindAll(const CharStringView& targetString) const
+{
+    return CharStringView(_data, _length).FindAll(targetString);
+}
 
-        while (_data[i] != targetString._data[j])
-        {
-            j = next[j];
-            if (j == -1)
-            {
-                i++;
-                j = 0;
-            }
-        }
 
-        if (i == _length)
-        {
-            delete[] next;
-            return -1;
-        }
-    }
+CharString CharString::GetSubstring(int left, int right) const
+{
+    return CharString(GetSubview(left, right));
 }
 
 
-CharString CharString::GetSubstring(int left, int right) const
+CharStringView CharString::GetSubview(int left, int right) const
 {
     if (left >= 0 && left < _length && right >= 0 && right <= _length && left <= right)
     {
-        CharString ret;
-        if (left == right)
-        {
-            return ret;
-        }
-        ret._data = new wchar_t[right - left];
-        ret._length = right - left;
-
-        for (auto i = 0; i < ret._length; i++)
-        {
-            ret._data[i] = _data[i + left];
-        }
-
-        return ret;
+        return CharStringView(_data + left, right - left);
     }
-    throw std::out_of_range("Index out of range in CharString::SubString");
+    throw std::out_of_range("Index out of range in CharString::GetSubview");
 }
 
 
@@ -238,47 +227,48 @@ void CharString::Concat(const CharString& rhs)
         return;
     }
 
-    auto newData = new wchar_t[_length + rhs._length];
-
-    for (auto i = 0; i < _length; i++)
+    const auto newLength = _length + rhs._length;
+    if (newLength <= InlineCapacity)
     {
-        newData[i] = _data[i];
+        // Both are inline, the characters fit after the current ones.
+        std::copy(rhs._data, rhs._data + rhs._length, _inline + _length);
     }
-
-    for (auto i = _length; i < _length + rhs._length; i++)
+    else
     {
-        newData[i] = rhs._data[i - _length];
-    }
+        auto newData = new wchar_t[newLength];
+        std::copy(_data, _data + _length, newData);
+        std::copy(rhs._data, rhs._data + rhs._length, newData + _length);
 
-    _length = _length + rhs._length;
-    delete[] _data;
-    _data = newData;
+        if (!IsInline())
+        {
+            delete[] _data;
+        }
+        _data = newData;
+    }
 
+    _length = newLength;
     UpdateHashCode();
 }
 
 
 void CharString::Assign(const CharString& rhs)
 {
-    delete[] _data;
-    _data = nullptr;
-    _length = rhs._length;
-
-    if (_length > 0)
+    if (this == &rhs)
     {
-        _data = new wchar_t[_length];
-
-        for (auto i = 0; i < _length; i++)
-        {
-            _data[i] = rhs._data[i];
-        }
+        return;
     }
 
-    UpdateHashCode();
+    SetContent(rhs._data, rhs._length);
 }
 
 
-unsigned CharString::GetHashCode() const
+void CharString::Assign(const CharStringView& rhs)
+{
+    SetContent(rhs.GetData(), rhs.GetLength());
+}
+
+
+std::uint64_t CharString::GetHashCode() const
 {
     return _hashCode;
 }
@@ -291,23 +281,26 @@ CharString& CharString::operator=(const CharString& rhs)
 }
 
 
-void CharString::FromStdWstring(const std::wstring& rhs)
+CharString& CharString::operator=(CharString&& rhs) noexcept
 {
-    delete[] _data;
-    _data = nullptr;
-    _length = rhs.size();
-
-    if (_length > 0)
+    if (this != &rhs)
     {
-        _data = new wchar_t[_length];
-
-        for (auto i = 0; i < _length; i++)
+        if (!IsInline())
         {
-            _data[i] = rhs[i];
+            delete[] _data;
+            _data = _inline;
         }
+
+        TakeOver(rhs);
     }
 
-    UpdateHashCode();
+    return (*this);
+}
+
+
+void CharString::FromStdWstring(const std::wstring& rhs)
+{
+    SetContent(rhs.data(), static_cast<int>(rhs.size()));
 }
 
 
@@ -317,32 +310,26 @@ std::wstring CharString::ToStdWstring() const
 }
 
 
-bool CharString::operator==(const CharString& rhs) const
+CharString::operator CharStringView() const
 {
-    if (_data == nullptr && rhs._data == nullptr)
-    {
-        return true;
-    }
+    return CharStringView(_data, _length);
+}
 
-    if (_data == nullptr || rhs._data == nullptr)
-    {
-        return false;
-    }
 
+bool CharString::operator==(const CharString& rhs) const
+{
     if (_length != rhs._length)
     {
         return false;
     }
 
-    for (auto i = 0; i < _length; i++)
+    // Strings with different hash codes can not be equal.
+    if (_hashCode != rhs._hashCode)
     {
-        if (_data[i] != rhs._data[i])
-        {
-            return false;
-        }
+        return false;
     }
 
-    return true;
+    return std::equal(_data, _data + _length, rhs._data);
 }
 
 
@@ -396,7 +383,10 @@ inline bool CharString::operator>=(const CharString& rhs) const
 
 CharString::~CharString()
 {
-    delete[] _data;
+    if (!IsInline())
+    {
+        delete[] _data;
+    }
 }
 
 
@@ -408,7 +398,7 @@ const wchar_t CharString::operator[](int index) const
 
 bool CharString::IsEmpty() const
 {
-    return _data == nullptr;
+    return _length == 0;
 }
 
 
@@ -426,7 +416,6 @@ bool CharString::IsSpace(wchar_t character)
 
 CharString::CharString()
 {
-    UpdateHashCode();
 }
 
 
@@ -438,11 +427,7 @@ CharString::CharString(const CharString& rhs)
 
 CharString::CharString(CharString&& rhs) noexcept
 {
-    _length = rhs._length;
-    _data = rhs._data;
-    rhs._data = nullptr;
-
-    UpdateHashCode();
+    TakeOver(rhs);
 }
 
 
@@ -460,15 +445,77 @@ void CharString::Replace(wchar_t from, wchar_t to)
 }
 
 
-void CharString::UpdateHashCode()
+void CharString::SetContent(const wchar_t* data, const int length)
 {
-    auto sum = 0u;
-    for (auto i = 0; i < _length; i++)
+    const auto newData = length <= InlineCapacity ? _inline : new wchar_t[length];
+
+    // Copy before releasing the old buffer, the characters may be in it.
+    std::copy_n(data, length, newData);
+    if (!IsInline() && _data != newData)
     {
-        sum += sum * 7 + _data[i];
+        delete[] _data;
     }
 
-    _hashCode = HashMin + sum % (HashMax - HashMin);
+    _data = newData;
+    _length = length;
+    UpdateHashCode();
+}
+
+
+void CharString::TakeOver(CharString& rhs)
+{
+    if (rhs.IsInline())
+    {
+        std::copy(rhs._inline, rhs._inline + rhs._length, _inline);
+        _data = _inline;
+    }
+    else
+    {
+        _data = rhs._data;
+    }
+
+    _length = rhs._length;
+    _hashCode = rhs._hashCode;
+
+    rhs._data = rhs._inline;
+    rhs._length = 0;
+    rhs._hashCode = CharStringView::ComputeHashCode(nullptr, 0);
+}
+
+
+void CharString::Adopt(wchar_t* buffer, const int length)
+{
+    if (!IsInline())
+    {
+        delete[] _data;
+    }
+
+    if (length <= InlineCapacity)
+    {
+        std::copy_n(buffer, length, _inline);
+        delete[] buffer;
+        _data = _inline;
+    }
+    else
+    {
+        _data = buffer;
+    }
+
+    _length = length;
+    UpdateHashCode();
+}
+
+
+bool CharString::IsInline() const
+{
+    return _data == _inline;
+}
+
+
+void CharString::UpdateHashCode()
+{
+    // The content was just written, so hashing it costs no more than the writing did.
+    _hashCode = CharStringView::ComputeHashCode(_data, _length);
 }
 
 
@@ -478,4 +525,10 @@ CharString::CharString(const std::wstring& rhs)
 }
 
 
+CharString::CharString(const CharStringView& rhs)
+{
+    Assign(rhs);
+}
+
+
 #endif //DATASTRUCTUREPROJECT_CHARSTRING_HPP
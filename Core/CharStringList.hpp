@@ -8,7 +8,8 @@
 #include "LinkedList.hpp"
 #include "CharString.hpp"
 
-using CharStringList = LinkedList<CharString>;
+/// \brief A list of words, its nodes are carved from an arena owned by the list.
+using CharStringList = LinkedList<CharString, ArenaNodeAllocator>;
 
 CharStringList Split(const CharString& charString, wchar_t delimeter)
 {
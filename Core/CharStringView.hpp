@@ -0,0 +1,339 @@
+//
+// Created on 2026/10/16 at 16:00.
+//
+
+#ifndef DATASTRUCTUREPROJECT_CHARSTRINGVIEW_HPP
+#define DATASTRUCTUREPROJECT_CHARSTRINGVIEW_HPP
+
+#include <string>
+#include <cwchar>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include "Simd.hpp"
+
+
+/// \brief A non-owning slice of <code>wchar_t</code>, the characters must outlive the view.
+/// \note Hashes and compares the same as <code>CharString</code>,
+/// so it can be used to look up containers keyed by <code>CharString</code> without copying.
+class CharStringView
+{
+public:
+    CharStringView() = default;
+
+    /// \brief Create a view of some characters.
+    /// \param data Pointer to the first character.
+    /// \param length The number of characters.
+    CharStringView(const wchar_t* data, int length);
+
+    /// \brief Create a view of a null-terminated string, usually a literal.
+    /// \param data The null-terminated string.
+    CharStringView(const wchar_t* data);
+
+    /// \brief Get the view of a part of the instance.
+    /// \param left Starting character position of the subview in the instance.
+    /// \param right Ending character position of the subview in the instance.
+    /// \return The view of characters indexed with [<code>left</code>,<code>right</code>) in the instance.
+    /// \throw std::out_of_range if the indexes are invalid.
+    CharStringView GetSubview(int left, int right) const;
+
+    /// \brief Get the index of the first occurrence of a target string in the instance.
+    /// \param target The string to locate in the instance.
+    /// \param start The index to start searching from.
+    /// \return The index of the first occurrence at or after <code>start</code>, -1 if it is not found.
+    /// \throw std::logic_error if the target is empty.
+    /// \note The candidates are the positions where both the first and the last characters of the target match,
+    /// they are found a group at a time with <code>Simd::MatchCharPair</code>. Nothing is allocated.
+    int IndexOf(const CharStringView& target, int start = 0) const;
+
+    /// \brief Get the indexes of all the occurrences of a target string in the instance.
+    /// \param target The string to locate in the instance.
+    /// \return The indexes in ascending order, the occurrences do not overlap.
+    /// \throw std::logic_error if the target is empty.
+    std::vector<int> FindAll(const CharStringView& target) const;
+
+    /// \brief Get the hash code of the instance, the same as a <code>CharString</code> of the same content.
+    /// \return The hash code of the instance.
+    /// \note It is computed on each call, the view does not cache it.
+    std::uint64_t GetHashCode() const;
+
+    /// \brief Translate the instance to a std::wstring.
+    /// \return The translated std::wstring.
+    std::wstring ToStdWstring() const;
+
+    /// \brief Get the character at a specific index of the instance.
+    /// \param index The position of the character need to get.
+    /// \return The character on the position <code>index</code>.
+    wchar_t operator[](int index) const;
+
+    /// \brief Get the pointer to the first character.
+    /// \return Pointer to the first character, may be nullptr if the instance is empty.
+    const wchar_t* GetData() const;
+
+    /// \brief Get the length of the instance.
+    /// \return The number of characters.
+    int GetLength() const;
+
+    /// \brief Test if the instance is empty.
+    /// \return True if the length is 0, otherwise false.
+    bool IsEmpty() const;
+
+    /// \brief Calculate the hash code of some characters.
+    /// \param data Pointer to the first character.
+    /// \param length The number of characters.
+    /// \return The hash code, all the 64 bits are mixed, a container reduces it to the size of its table.
+    /// \note The bytes of the characters are read 16 at a time into two independent lanes,
+    /// with the rounds and the final mixing of XXH64.
+    static std::uint64_t ComputeHashCode(const wchar_t* data, int length);
+
+private:
+    const wchar_t* _data = nullptr;
+    int _length = 0;
+
+    /// \brief Mix 8 bytes into a lane.
+    static std::uint64_t MixRound(std::uint64_t lane, std::uint64_t word);
+
+    /// \brief Read up to 8 bytes as a little-endian word, the missing high bytes are zeros.
+    static std::uint64_t ReadWord(const unsigned char* bytes, std::uint64_t size);
+
+    static std::uint64_t RotateLeft(std::uint64_t value, int count);
+};
+
+
+bool operator==(const CharStringView& lhs, const CharStringView& rhs);
+bool operator!=(const CharStringView& lhs, const CharStringView& rhs);
+bool operator<(const CharStringView& lhs, const CharStringView& rhs);
+bool operator>(const CharStringView& lhs, const CharStringView& rhs);
+bool operator<=(const CharStringView& lhs, const CharStringView& rhs);
+bool operator>=(const CharStringView& lhs, const CharStringView& rhs);
+
+
+inline CharStringView::CharStringView(const wchar_t* data, const int length)
+    : _data(data), _length(length)
+{
+}
+
+
+inline CharStringView::CharStringView(const wchar_t* data)
+    : _data(data), _length(static_cast<int>(std::wcslen(data)))
+{
+}
+
+
+inline CharStringView CharStringView::GetSubview(const int left, const int right) const
+{
+    if (left >= 0 && right <= _length && left <= right)
+    {
+        return CharStringView(_data + left, right - left);
+    }
+
+    throw std::out_of_range("Index out of range in CharStringView::GetSubview()");
+}
+
+
+inline int CharStringView::IndexOf(const CharStringView& target, const int start) const
+{
+    if (target._length == 0)
+    {
+        throw std::logic_error("Target string is empty in CharStringView::IndexOf()");
+    }
+
+    // The last position an occurrence can start at.
+    const auto limit = _length - target._length;
+    const auto first = target._data[0];
+    const auto last = target._data[target._length - 1];
+
+    // The characters between the first and the last, compared only for the candidates.
+    const auto middle = target._data + 1;
+    const auto middleLength = std::max(target._length - 2, 0);
+
+    auto i = std::max(start, 0);
+    for (; i + Simd::CharGroupWidth - 1 <= limit; i += Simd::CharGroupWidth)
+    {
+        auto mask = Simd::MatchCharPair(_data + i, first, _data + i + target._length - 1, last);
+        while (mask != 0)
+        {
+            const auto candidate = i + Simd::CountTrailingZeros(mask);
+            if (std::equal(middle, middle + middleLength, _data + candidate + 1))
+            {
+                return candidate;
+            }
+
+            mask &= mask - 1;
+        }
+    }
+
+    for (; i <= limit; i++)
+    {
+        if (_data[i] == first && _data[i + target._length - 1] == last &&
+            std::equal(middle, middle + middleLength, _data + i + 1))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+
+inline std::vector<int> CharStringView::FindAll(const CharStringView& target) const
+{
+    std::vector<int> indexes;
+    for (auto index = IndexOf(target); index != -1; index = IndexOf(target, index + target._length))
+    {
+        indexes.push_back(index);
+    }
+
+    return indexes;
+}
+
+
+inline std::uint64_t CharStringView::GetHashCode() const
+{
+    return ComputeHashCode(_data, _length);
+}
+
+
+inline std::wstring CharStringView::ToStdWstring() const
+{
+    return std::wstring(_data, _length);
+}
+
+
+inline wchar_t CharStringView::operator[](const int index) const
+{
+    return _data[index];
+}
+
+
+inline const wchar_t* CharStringView::GetData() const
+{
+    return _data;
+}
+
+
+inline int CharStringView::GetLength() const
+{
+    return _length;
+}
+
+
+inline bool CharStringView::IsEmpty() const
+{
+    return _length == 0;
+}
+
+
+inline std::uint64_t CharStringView::ComputeHashCode(const wchar_t* data, const int length)
+{
+    const auto bytes = reinterpret_cast<const unsigned char*>(data);
+    const auto size = static_cast<std::uint64_t>(length) * sizeof(wchar_t);
+
+    auto lane1 = 0x9E3779B185EBCA87ull + 0xC2B2AE3D27D4EB4Full;
+    auto lane2 = 0xC2B2AE3D27D4EB4Full;
+
+    std::uint64_t offset = 0;
+    for (; offset + 16 <= size; offset += 16)
+    {
+        lane1 = MixRound(lane1, ReadWord(bytes + offset, 8));
+        lane2 = MixRound(lane2, ReadWord(bytes + offset + 8, 8));
+    }
+
+    // The tail is padded with zeros, the size mixed below tells it apart from a longer string.
+    if (offset < size)
+    {
+        const auto rest = size - offset;
+        lane1 = MixRound(lane1, ReadWord(bytes + offset, std::min<std::uint64_t>(rest, 8)));
+        if (rest > 8)
+        {
+            lane2 = MixRound(lane2, ReadWord(bytes + offset + 8, rest - 8));
+        }
+    }
+
+    auto hash = RotateLeft(lane1, 1) + RotateLeft(lane2, 7) + size;
+    hash ^= hash >> 33;
+    hash *= 0xC2B2AE3D27D4EB4Full;
+    hash ^= hash >> 29;
+    hash *= 0x165667B19E3779F9ull;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+
+inline std::uint64_t CharStringView::MixRound(const std::uint64_t lane, const std::uint64_t word)
+{
+    return RotateLeft(lane + word * 0xC2B2AE3D27D4EB4Full, 31) * 0x9E3779B185EBCA87ull;
+}
+
+
+inline std::uint64_t CharStringView::ReadWord(const unsigned char* bytes, const std::uint64_t size)
+{
+    if (size == 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        return word;
+    }
+
+    std::uint64_t word = 0;
+    for (std::uint64_t i = 0; i < size; i++)
+    {
+        word |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+    }
+
+    return word;
+}
+
+
+inline std::uint64_t CharStringView::RotateLeft(const std::uint64_t value, const int count)
+{
+    return (value << count) | (value >> (64 - count));
+}
+
+
+inline bool operator==(const CharStringView& lhs, const CharStringView& rhs)
+{
+    if (lhs.GetLength() != rhs.GetLength())
+    {
+        return false;
+    }
+
+    return std::equal(lhs.GetData(), lhs.GetData() + lhs.GetLength(), rhs.GetData());
+}
+
+
+inline bool operator!=(const CharStringView& lhs, const CharStringView& rhs)
+{
+    return !(lhs == rhs);
+}
+
+
+inline bool operator<(const CharStringView& lhs, const CharStringView& rhs)
+{
+    return std::lexicographical_compare(lhs.GetData(), lhs.GetData() + lhs.GetLength(),
+                                        rhs.GetData(), rhs.GetData() + rhs.GetLength());
+}
+
+
+inline bool operator>(const CharStringView& lhs, const CharStringView& rhs)
+{
+    return rhs < lhs;
+}
+
+
+inline bool operator<=(const CharStringView& lhs, const CharStringView& rhs)
+{
+    return !(rhs < lhs);
+}
+
+
+inline bool operator>=(const CharStringView& lhs, const CharStringView& rhs)
+{
+    return !(lhs < rhs);
+}
+
+
+#endif //DATASTRUCTUREPROJECT_CHARSTRINGVIEW_HPP
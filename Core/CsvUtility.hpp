@@ -2,6 +2,7 @@
 
 #include "CharString.hpp"
 #include "CharStringList.hpp"
+#include "StringBuilder.hpp"
 
 
 /// \brief A class to simplify CSV operations.
@@ -26,43 +27,37 @@ public:
 
 CharString CsvUtility::CsvEncode(const CharStringList& charStringList, bool withQuotationMark)
 {
-    CharString ret;
+    StringBuilder ret;
     bool isFirst = true;
 
     std::function<void(const CharString&)> visitFunction = [&ret, &isFirst, withQuotationMark
         ](const CharString& charString) -> void
     {
-        std::wstring quatationMarkStd = L"\"";
-        auto quatationMark = CharString();
-        quatationMark.FromStdWstring(quatationMarkStd);
-
         if (isFirst)
         {
             isFirst = false;
         }
         else
         {
-            CharString c;
-            c.FromStdWstring(L",");
-            ret.Concat(c);
+            ret.Append(L',');
         }
 
         if (withQuotationMark)
         {
-            ret.Concat(quatationMark);
+            ret.Append(L'\"');
         }
 
-        ret.Concat(charString);
+        ret.Append(charString);
 
         if (withQuotationMark)
         {
-            ret.Concat(quatationMark);
+            ret.Append(L'\"');
         }
     };
 
     const_cast<CharStringList&>(charStringList).Iterate(visitFunction);
 
-    return ret;
+    return ret.ToCharString();
 }
 
 
@@ -7,8 +7,15 @@
 
 #include <fstream>
 #include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
 #include "LinkedList.hpp"
 #include "CharStringList.hpp"
+#include "DoubleArrayTrie.hpp"
+#include "TermTable.hpp"
+#include "Transcoder.hpp"
 
 
 /// \brief A class used to split words.
@@ -20,150 +27,190 @@ public:
     /// \note The class will use those dictionaries to check if a string is a word or not.
     /// The dictionary file is a text file,
     /// each line of which is a word and there is not blank line at the end of the file.
+    /// The trie is compiled again after each dictionary, so add all the dictionaries before splitting.
     void AddDictionary(const std::string& filePath);
 
     /// \brief Test if a string is a word in the dictionary.
-    /// \param word A string to be tested.
+    /// \param word A string to be tested, a <code>CharString</code> or a view of one.
     /// \return True if it is a word, otherwise false.
-    bool ContainsWord(const CharString& word) const;
+    bool ContainsWord(const CharStringView& word) const;
 
-    /// \brief Split the sentence to a list of words.
+    /// \brief Split the sentence to words.
     /// \param sentence The sentence to be splited.
-    /// \return A list containing all the words in it.
+    /// \param terms The table to intern the words in.
+    /// \return The term ids of all the words in it, in order.
     /// \note All the control characters, punctuations, letters and numbers are ignored.
-    CharStringList WordSplit(const CharString& sentence) const;
-
-    virtual ~Dictionary();
-private:
-    /// \brief Pointer to the hash table used for word looking up.
-    CharStringList* _hashTable = nullptr;
-
-    /// \brief Cached maximium length of the words.
-    int _maxWordLength = 1;
+    /// Words are found by reverse maximum matching, each position is matched by a single walk in the trie.
+    /// The words are interned straight from the sentence, no string is copied unless the word is new.
+    std::vector<std::uint32_t> WordSplit(const CharString& sentence, TermTable& terms) const;
 
     /// \brief Test if a character is a stop word.
     /// \param word The character to be tested.
     /// \return True if <code>character</code> is a stop word, otherwise false.
     /// \note A stop word is one of the characters, the punctuations, the letters and the numbers.
+    /// The characters below 256 are looked up in a bitmap, the others in a few ranges of punctuations.
     static bool IsStopWord(wchar_t word);
-};
 
+    virtual ~Dictionary() = default;
+private:
+    /// \brief All the words added, reversed, used to compile the trie.
+    std::vector<std::wstring> _reversedWords;
 
-inline void Dictionary::AddDictionary(const std::string& filePath)
-{
-    if (_hashTable == nullptr)
+    /// \brief Trie of the reversed words, walked from the end of a word to its beginning.
+    DoubleArrayTrie _trie;
+
+    /// \brief The stop words below 256 as a bitmap, built at compile time.
+    class StopWordTable
     {
-        _hashTable = new CharStringList[CharString::HashMax - CharString::HashMin];
-    }
+    public:
+        std::uint64_t Bitmap[4];
 
-    std::wifstream fin;
-    fin.imbue(std::locale("chs"));
-    fin.open(filePath);
+        constexpr StopWordTable();
 
-    std::wstring readingLine;
-    auto co = 0;
+    private:
+        constexpr void Add(unsigned int character);
+    };
+};
 
-    while (getline(fin, readingLine))
-    {
-        co++;
-        CharString item;
-        item.FromStdWstring(readingLine);
-        _hashTable[item.GetHashCode() - CharString::HashMin].Append(item);
 
-        if (item.GetLength() > _maxWordLength)
+inline void Dictionary::AddDictionary(const std::string& filePath)
+{
+    // The dictionaries are in GBK.
+    for (auto& readingLine : Transcoder::ReadLines(filePath, Transcoder::Encoding::Gb18030))
+    {
+        if (!readingLine.empty())
         {
-            _maxWordLength = item.GetLength();
+            std::reverse(readingLine.begin(), readingLine.end());
+            _reversedWords.push_back(readingLine);
         }
     }
+
+    _trie.Build(_reversedWords);
 }
 
 
-inline bool Dictionary::ContainsWord(const CharString& word) const
+inline bool Dictionary::ContainsWord(const CharStringView& word) const
 {
-    if (_hashTable == nullptr)
+    auto state = DoubleArrayTrie::Root;
+    for (auto i = word.GetLength() - 1; i >= 0; i--)
     {
-        return false;
+        if (!_trie.Transit(state, word[i]))
+        {
+            return false;
+        }
     }
 
-    const auto hashCode = word.GetHashCode();
-
-    return _hashTable[hashCode - CharString::HashMin].IndexOf(word) != -1;
+    return _trie.IsKey(state);
 }
 
 
-inline CharStringList Dictionary::WordSplit(const CharString& sentence) const
+inline std::vector<std::uint32_t> Dictionary::WordSplit(const CharString& sentence, TermTable& terms) const
 {
-    CharStringList ret;
+    // The words are found from the end, so they are collected backwards and reversed at last.
+    std::vector<std::uint32_t> ret;
     auto right = sentence.GetLength();
 
     while (right > 0)
     {
-        auto wordFound = false;
-        const auto start = _maxWordLength > right ? right : _maxWordLength;
-        for (auto i = start; i > 1; i--)
+        // Walk backwards from right, the last key passed is the longest word ending at right.
+        auto matchedLength = 0;
+        auto state = DoubleArrayTrie::Root;
+
+        for (auto i = right - 1; i >= 0 && _trie.Transit(state, sentence[i]); i--)
         {
-            if (right - i >= 0)
+            if (_trie.IsKey(state))
             {
-                const auto substring = sentence.GetSubstring(right - i, right);
-                if (ContainsWord(substring))
-                {
-                    ret.InsertAt(substring, 0);
-                    right = right - i;
-                    wordFound = true;
-                    break;
-                }
+                matchedLength = right - i;
             }
         }
 
-        if (!wordFound)
+        // Single characters are not looked up, they are handled below.
+        if (matchedLength > 1)
+        {
+            ret.push_back(terms.Intern(sentence.GetSubview(right - matchedLength, right)));
+            right = right - matchedLength;
+        }
+        else
         {
             const auto adding = sentence[right - 1];
             if (!IsStopWord(adding))
             {
-                ret.InsertAt(sentence.GetSubstring(right - 1, right), 0);
+                ret.push_back(terms.Intern(sentence.GetSubview(right - 1, right)));
             }
 
             right--;
         }
     }
 
+    std::reverse(ret.begin(), ret.end());
     return ret;
 }
 
-inline Dictionary::~Dictionary()
+constexpr Dictionary::StopWordTable::StopWordTable()
+    : Bitmap()
 {
-    delete[] _hashTable;
+    // The spaces, all the ASCII punctuations, the no-break space and the middle dot.
+    const wchar_t* characters = L" \n\t`~!@#$%^&*()-=_+[]\\{}|;':\",./<>?\u00a0\u00b7";
+    for (auto i = 0; characters[i] != L'\0'; i++)
+    {
+        Add(static_cast<unsigned int>(characters[i]));
+    }
+
+    Add(0);
+    for (auto i = 0u; i < 26; i++)
+    {
+        Add(L'a' + i);
+        Add(L'A' + i);
+    }
+    for (auto i = 0u; i < 10; i++)
+    {
+        Add(L'0' + i);
+    }
+}
+
+
+constexpr void Dictionary::StopWordTable::Add(const unsigned int character)
+{
+    Bitmap[character / 64] |= std::uint64_t(1) << character % 64;
 }
 
 
 inline bool Dictionary::IsStopWord(const wchar_t word)
 {
-    return
-        word == L' ' || word == L'\0' || word == L'\n' || word == L'\t' ||
-        word == L'`' || word == L'~' || word == L'!' || word == L'@' || word == L'#' ||
-        word == L'$' || word == L'%' || word == L'^' || word == L'&' || word == L'*' ||
-        word == L'(' || word == L')' || word == L'-' || word == L'=' || word == L'_' ||
-        word == L'+' || word == L'[' || word == L']' || word == L'\\' || word == L'{' ||
-        word == L'}' || word == L'|' || word == L';' || word == L'\'' || word == L':' ||
-        word == L'"' || word == L',' || word == L'.' || word == L'/' || word == L'<' ||
-        word == L'>' || word == L'?' || word == L'·' || word == L'！' || word == L'￥' ||
-        word == L'…' || word == L'（' || word == L'）' || word == L'—' || word == L'【' ||
-        word == L'】' || word == L'、' || word == L'；' || word == L'：' || word == L'‘' ||
-        word == L'’' || word == L'“' || word == L'”' || word == L'，' || word == L'。' ||
-        word == L'《' || word == L'》' || word == L'/' || word == L'？' || word == L'q' ||
-        word == L'w' || word == L'e' || word == L'r' || word == L't' || word == L'y' ||
-        word == L'u' || word == L'i' || word == L'o' || word == L'p' || word == L'a' ||
-        word == L's' || word == L'd' || word == L'f' || word == L'g' || word == L'h' ||
-        word == L'j' || word == L'k' || word == L'l' || word == L'z' || word == L'x' ||
-        word == L'c' || word == L'v' || word == L'b' || word == L'n' || word == L'm' ||
-        word == L'Q' || word == L'W' || word == L'E' || word == L'R' || word == L'T' ||
-        word == L'Y' || word == L'U' || word == L'I' || word == L'O' || word == L'P' ||
-        word == L'A' || word == L'S' || word == L'D' || word == L'F' || word == L'G' ||
-        word == L'H' || word == L'J' || word == L'K' || word == L'L' || word == L'Z' ||
-        word == L'X' || word == L'C' || word == L'V' || word == L'B' || word == L'N' ||
-        word == L'M' || word == L'1' || word == L'2' || word == L'3' || word == L'4' ||
-        word == L'5' || word == L'6' || word == L'7' || word == L'8' || word == L'9' ||
-        word == L'0' || word == 160;
+    static constexpr StopWordTable table;
+
+    // The full-width and CJK punctuations, sorted: — ‘’ “” … 、。 《》 【】 ！ （） ， ：； ？ ￥
+    static const wchar_t ranges[][2] = {
+        {0x2014, 0x2014}, {0x2018, 0x2019}, {0x201c, 0x201d}, {0x2026, 0x2026},
+        {0x3001, 0x3002}, {0x300a, 0x300b}, {0x3010, 0x3011},
+        {0xff01, 0xff01}, {0xff08, 0xff09}, {0xff0c, 0xff0c}, {0xff1a, 0xff1b}, {0xff1f, 0xff1f}, {0xffe5, 0xffe5}
+    };
+
+    const auto character = static_cast<unsigned int>(word);
+    if (character < 256)
+    {
+        return (table.Bitmap[character / 64] >> character % 64 & 1) != 0;
+    }
+
+    // Most of the characters are ideographs, they fall between the ranges and are rejected at once.
+    if (word < ranges[0][0] || (word > ranges[6][1] && word < ranges[7][0]))
+    {
+        return false;
+    }
+
+    for (const auto& range : ranges)
+    {
+        if (word < range[0])
+        {
+            return false;
+        }
+        if (word <= range[1])
+        {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 
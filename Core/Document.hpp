@@ -6,55 +6,97 @@
 #define DATASTRUCTUREPROJECT_DOCUMENT_HPP
 
 #include "CharString.hpp"
-#include "InformationExtracter.hpp"
+#include "Utf8String.hpp"
+#include "ExtractionPlan.hpp"
 #include "CharStringList.hpp"
-#include "Spider.hpp"
 #include "XmlParser.hpp"
 #include "Dictionary.hpp"
+#include "TermTable.hpp"
+#include "StringBuilder.hpp"
+
+#ifdef _MANAGED
+#include "Spider.hpp"
+#endif
 
+#include <cstdint>
 #include <fstream>
+#include <vector>
+#include <utility>
+#include <algorithm>
 
 class Document
 {
 public:
     int Id;
-    CharStringList Words;
-    CharString PostTitle;
-    CharString PostContent;
 
+    /// \brief Term ids of the words in the title and the content, in <code>TermTable::GetGlobal()</code>.
+    std::vector<std::uint32_t> Words;
+
+    /// \brief The title and the content are kept as UTF-8 for the lifetime of the index.
+    Utf8String PostTitle;
+    Utf8String PostContent;
+
+#ifdef _MANAGED
     void UpdateFromUrl(const std::wstring& url, const Dictionary& dictionary);
+#endif
+
+    /// \brief Extract the title and the content from a page and split them into words.
+    /// \param html Content of the page.
+    /// \param dictionary The dictionary to split the words with.
+    /// \throw std::exception if the page is not a thread.
+    void UpdateFromHtml(const CharString& html, const Dictionary& dictionary);
     void AssignId(const int id);
-    int CountWords(const CharString& word) const;
+
+    /// \brief Get the times a word occurs in the document.
+    /// \param termId Term id of the word to count.
+    /// \return The times it occurs, 0 if it does not occur.
+    /// \note Looked up in the term frequency table, call <code>UpdateTermFrequencies</code> first.
+    int CountWords(std::uint32_t termId) const;
+
+    /// \brief Count all the words in <code>Words</code> into the term frequency table.
+    /// \note Called by <code>UpdateFromHtml</code>, call it again if <code>Words</code> is modified.
+    void UpdateTermFrequencies();
+
+    /// \brief Get the term frequency table.
+    /// \return The term id of each distinct word and the times it occurs, in ascending order of term id.
+    const std::vector<std::pair<std::uint32_t, int>>& GetTermFrequencies() const;
+
+private:
+    std::vector<std::pair<std::uint32_t, int>> _termFrequencies;
 };
 
 
+#ifdef _MANAGED
 inline void Document::UpdateFromUrl(const std::wstring& url, const Dictionary& dictionary)
 {
-    XmlNode* xmlRoot = nullptr;
+    const CharString html(Spider::GetHtmlByUrl(url));
+    UpdateFromHtml(html, dictionary);
+}
+#endif
 
+inline void Document::UpdateFromHtml(const CharString& html, const Dictionary& dictionary)
+{
     try
     {
-        const auto htmlStd = Spider::GetHtmlByUrl(url);
-        const CharString html(htmlStd);
+        // One scan over the page extracts all the fields, no xml tree is built.
+        const auto record = ExtractionPlan::GetThreadPlan().Execute(html);
 
-        xmlRoot = XmlParser::ParseXml(html);
+        const auto& content = record.Get(ExtractionPlan::Field::PostContent);
+        const auto& title = record.Get(ExtractionPlan::Field::PostTitle);
 
-        auto extracter = InformationExtracter(xmlRoot);
+        PostContent.Assign(content);
+        PostTitle.Assign(title);
 
-        PostContent = extracter.GetPostContent();
-        PostTitle = extracter.GetPostTitle();
+        StringBuilder split(content.GetLength() + title.GetLength());
+        split.Append(content);
+        split.Append(title);
 
-        auto split = PostContent;
-        split.Concat(PostTitle);
-
-        Words = std::move(dictionary.WordSplit(split));
-        delete xmlRoot;
+        Words = dictionary.WordSplit(split.ToCharString(), TermTable::GetGlobal());
+        UpdateTermFrequencies();
     }
     catch (const std::exception&)
     {
-        // Some errors may occur in GetPostContent() or GetPostTitle().
-        // So xmlRoot won't be deleted due to try-catch blocks.
-        delete xmlRoot;
+        // The page may have no title or no content.
         throw std::exception();
     }
 }
@@ -64,18 +106,47 @@ inline void Document::AssignId(const int id)
     Id = id;
 }
 
-inline int Document::CountWords(const CharString& word) const
+inline int Document::CountWords(const std::uint32_t termId) const
+{
+    const auto location = std::lower_bound(_termFrequencies.begin(), _termFrequencies.end(), termId,
+                                           [](const std::pair<std::uint32_t, int>& item,
+                                              const std::uint32_t target)-> bool
+                                           {
+                                               return item.first < target;
+                                           }
+    );
+
+    if (location == _termFrequencies.end() || location->first != termId)
+    {
+        return 0;
+    }
+
+    return location->second;
+}
+
+inline void Document::UpdateTermFrequencies()
 {
-    auto count = 0;
-    for (const auto& i : Words)
+    // Sort the term ids so equal words are adjacent, then count each run.
+    auto sortedWords = Words;
+    std::sort(sortedWords.begin(), sortedWords.end());
+
+    _termFrequencies.clear();
+    for (const auto termId : sortedWords)
     {
-        if (i == word)
+        if (!_termFrequencies.empty() && _termFrequencies.back().first == termId)
+        {
+            _termFrequencies.back().second++;
+        }
+        else
         {
-            count++;
+            _termFrequencies.push_back(std::make_pair(termId, 1));
         }
     }
+}
 
-    return count;
+inline const std::vector<std::pair<std::uint32_t, int>>& Document::GetTermFrequencies() const
+{
+    return _termFrequencies;
 }
 
 
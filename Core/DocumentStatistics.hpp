@@ -0,0 +1,133 @@
+//
+// Created on 2026/10/16 at 11:20.
+//
+
+#ifndef DATASTRUCTUREPROJECT_DOCUMENTSTATISTICS_HPP
+#define DATASTRUCTUREPROJECT_DOCUMENTSTATISTICS_HPP
+
+#include <vector>
+#include <algorithm>
+
+
+/// \brief Lengths of the indexed documents, used for length normalization when ranking.
+/// \note The lengths are stored in an array indexed by document id, the ids are expected to be dense.
+class DocumentStatistics
+{
+public:
+    /// \brief Record the length of a document.
+    /// \param documentId Id of the document, must not be negative.
+    /// \param length The number of words in the document.
+    /// \note A document should only be recorded once.
+    void Add(int documentId, int length);
+
+    /// \brief Merge the documents recorded by another instance.
+    /// \param rhs The instance to merge from, its documents must not appear in the instance.
+    void Merge(const DocumentStatistics& rhs);
+
+    /// \brief Get the length of a document.
+    /// \param documentId Id of the document.
+    /// \return The number of words in the document, 0 if the document is not recorded.
+    int GetLength(int documentId) const;
+
+    /// \brief Get the number of recorded documents.
+    /// \return The number of recorded documents.
+    int GetDocumentCount() const;
+
+    /// \brief Get the average length of the recorded documents.
+    /// \return The average length, 0 if there is no document.
+    double GetAverageLength() const;
+
+    /// \brief Get the minimum length of the recorded documents.
+    /// \return The minimum length, 0 if there is no document.
+    int GetMinimumLength() const;
+
+private:
+    /// \brief Lengths of the documents indexed by id, 0 for unrecorded ids.
+    std::vector<int> _lengths;
+
+    /// \brief The cached number of documents.
+    int _documentCount = 0;
+
+    /// \brief The cached sum of the lengths.
+    long long _totalLength = 0;
+
+    /// \brief The cached minimum length.
+    int _minimumLength = 0;
+};
+
+
+inline void DocumentStatistics::Add(const int documentId, const int length)
+{
+    if (documentId >= static_cast<int>(_lengths.size()))
+    {
+        _lengths.resize(documentId + 1, 0);
+    }
+
+    _lengths[documentId] = length;
+    _minimumLength = _documentCount == 0 ? length : std::min(_minimumLength, length);
+    _documentCount++;
+    _totalLength += length;
+}
+
+
+inline void DocumentStatistics::Merge(const DocumentStatistics& rhs)
+{
+    if (rhs._documentCount == 0)
+    {
+        return;
+    }
+
+    if (rhs._lengths.size() > _lengths.size())
+    {
+        _lengths.resize(rhs._lengths.size(), 0);
+    }
+
+    for (auto i = 0; i < static_cast<int>(rhs._lengths.size()); i++)
+    {
+        if (rhs._lengths[i] != 0)
+        {
+            _lengths[i] = rhs._lengths[i];
+        }
+    }
+
+    _minimumLength = _documentCount == 0 ? rhs._minimumLength : std::min(_minimumLength, rhs._minimumLength);
+    _documentCount += rhs._documentCount;
+    _totalLength += rhs._totalLength;
+}
+
+
+inline int DocumentStatistics::GetLength(const int documentId) const
+{
+    if (documentId < 0 || documentId >= static_cast<int>(_lengths.size()))
+    {
+        return 0;
+    }
+
+    return _lengths[documentId];
+}
+
+
+inline int DocumentStatistics::GetDocumentCount() const
+{
+    return _documentCount;
+}
+
+
+inline double DocumentStatistics::GetAverageLength() const
+{
+    if (_documentCount == 0)
+    {
+        return 0;
+    }
+
+    return static_cast<double>(_totalLength) / _documentCount;
+}
+
+
+inline int DocumentStatistics::GetMinimumLength() const
+{
+    return _minimumLength;
+}
+
+
+#endif //DATASTRUCTUREPROJECT_DOCUMENTSTATISTICS_HPP
@@ -0,0 +1,340 @@
+//
+// Created on 2026/10/16 at 15:05.
+//
+
+#ifndef DATASTRUCTUREPROJECT_DOUBLEARRAYTRIE_HPP
+#define DATASTRUCTUREPROJECT_DOUBLEARRAYTRIE_HPP
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+
+/// \brief A trie compiled into two flat arrays, walking one character costs two array lookups.
+/// \note A state <code>s</code> has a transition on character code <code>c</code>
+/// if <code>Check[Base[s] + c] == s</code>, and the next state is <code>Base[s] + c</code>.
+/// Characters are mapped to dense codes first, the most frequent characters get the smallest codes.
+class DoubleArrayTrie
+{
+public:
+    /// \brief The state before any character is walked.
+    static const int Root = 0;
+
+    /// \brief Create an empty trie, only containing the root.
+    DoubleArrayTrie();
+
+    /// \brief Compile the trie from a set of keys, the previous content is discarded.
+    /// \param keys The keys, they will be sorted and duplicates will be removed.
+    void Build(std::vector<std::wstring>& keys);
+
+    /// \brief Walk one character from a state.
+    /// \param state The state to walk from, it will be updated to the next state if the transition exists.
+    /// \param character The character to walk.
+    /// \return True if the transition exists, otherwise false and <code>state</code> is not modified.
+    bool Transit(int& state, wchar_t character) const;
+
+    /// \brief Test if the characters walked from the root to a state form a key.
+    /// \param state The state.
+    /// \return True if it is the end of a key, otherwise false.
+    bool IsKey(int state) const;
+
+    /// \brief Test if a string is a key.
+    /// \param key The string to be tested.
+    /// \return True if it is a key, otherwise false.
+    bool Contains(const std::wstring& key) const;
+
+    /// \brief Get the size of the arrays.
+    /// \return The number of units.
+    int GetUnitCount() const;
+
+private:
+    class Unit
+    {
+    public:
+        /// \brief Offset of the children, the child on code <code>c</code> is at <code>Base + c</code>.
+        int Base = 0;
+
+        /// \brief The parent state, -1 if the unit is free.
+        int Check = -1;
+
+        /// \brief If the state is the end of a key.
+        bool IsKey = false;
+    };
+
+    std::vector<Unit> _units;
+
+    /// \brief Codes of the characters indexed by character, 0 for characters not in any key.
+    std::vector<int> _codes;
+
+    /// \brief Get the code of a character.
+    int GetCode(wchar_t character) const;
+
+    /// \brief Place the children of a state and then the subtrees below them.
+    /// \param keys All the sorted keys.
+    /// \param begin The first key below the state.
+    /// \param end Past the last key below the state.
+    /// \param depth Length of the prefix walked to the state.
+    /// \param state The state.
+    /// \param nextCheckPosition The first position worth trying when placing children.
+    void Place(const std::vector<std::wstring>& keys, int begin, int end, int depth, int state,
+               int& nextCheckPosition);
+
+    /// \brief Find a base at which all the codes land on free units.
+    /// \param codes The codes of the children, in ascending order.
+    /// \param nextCheckPosition The first position worth trying, it will be updated.
+    /// \return The base.
+    int FindBase(const std::vector<int>& codes, int& nextCheckPosition);
+
+    /// \brief Make sure a position is inside the arrays.
+    void Reserve(int position);
+};
+
+
+inline DoubleArrayTrie::DoubleArrayTrie()
+    : _units(1)
+{
+    _units[Root].Check = Root;
+}
+
+
+inline void DoubleArrayTrie::Build(std::vector<std::wstring>& keys)
+{
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    // Count the characters and give the most frequent ones the smallest codes, they are placed more often.
+    std::vector<std::pair<int, unsigned int>> frequencies;
+    for (const auto& key : keys)
+    {
+        for (const auto character : key)
+        {
+            const auto index = static_cast<unsigned int>(character);
+            if (index >= frequencies.size())
+            {
+                const auto oldSize = static_cast<unsigned int>(frequencies.size());
+                frequencies.resize(index + 1);
+                for (auto i = oldSize; i <= index; i++)
+                {
+                    frequencies[i] = std::make_pair(0, i);
+                }
+            }
+
+            frequencies[index].first++;
+        }
+    }
+
+    _codes.assign(frequencies.size(), 0);
+    std::sort(frequencies.begin(), frequencies.end(),
+              [](const std::pair<int, unsigned int>& lhs, const std::pair<int, unsigned int>& rhs)-> bool
+              {
+                  return lhs.first > rhs.first;
+              }
+    );
+
+    for (auto i = 0; i < static_cast<int>(frequencies.size()) && frequencies[i].first > 0; i++)
+    {
+        _codes[frequencies[i].second] = i + 1;
+    }
+
+    _units.clear();
+    Reserve(Root);
+    _units[Root].Check = Root;
+
+    auto nextCheckPosition = 1;
+    Place(keys, 0, static_cast<int>(keys.size()), 0, Root, nextCheckPosition);
+
+    // Drop the free units at the end.
+    auto size = static_cast<int>(_units.size());
+    while (size > 1 && _units[size - 1].Check == -1)
+    {
+        size--;
+    }
+
+    _units.resize(size);
+    _units.shrink_to_fit();
+}
+
+
+inline bool DoubleArrayTrie::Transit(int& state, const wchar_t character) const
+{
+    const auto code = GetCode(character);
+    if (code == 0)
+    {
+        return false;
+    }
+
+    const auto next = _units[state].Base + code;
+    if (next >= static_cast<int>(_units.size()) || _units[next].Check != state)
+    {
+        return false;
+    }
+
+    state = next;
+    return true;
+}
+
+
+inline bool DoubleArrayTrie::IsKey(const int state) const
+{
+    return _units[state].IsKey;
+}
+
+
+inline bool DoubleArrayTrie::Contains(const std::wstring& key) const
+{
+    auto state = Root;
+    for (const auto character : key)
+    {
+        if (!Transit(state, character))
+        {
+            return false;
+        }
+    }
+
+    return IsKey(state);
+}
+
+
+inline int DoubleArrayTrie::GetUnitCount() const
+{
+    return static_cast<int>(_units.size());
+}
+
+
+inline int DoubleArrayTrie::GetCode(const wchar_t character) const
+{
+    const auto index = static_cast<unsigned int>(character);
+    return index < _codes.size() ? _codes[index] : 0;
+}
+
+
+inline void DoubleArrayTrie::Place(const std::vector<std::wstring>& keys, int begin, const int end,
+                                   const int depth, const int state, int& nextCheckPosition)
+{
+    // Keys are sorted, so the key ending here comes first and the children are contiguous ranges.
+    if (begin < end && static_cast<int>(keys[begin].size()) == depth)
+    {
+        _units[state].IsKey = true;
+        begin++;
+    }
+
+    if (begin == end)
+    {
+        return;
+    }
+
+    // (code, first key, past the last key) of each child.
+    class Child
+    {
+    public:
+        int Code;
+        int Begin;
+        int End;
+    };
+
+    std::vector<Child> children;
+    for (auto i = begin; i < end; i++)
+    {
+        const auto code = GetCode(keys[i][depth]);
+        if (children.empty() || children.back().Code != code)
+        {
+            children.push_back(Child{code, i, i + 1});
+        }
+        else
+        {
+            children.back().End = i + 1;
+        }
+    }
+
+    std::sort(children.begin(), children.end(), [](const Child& lhs, const Child& rhs)-> bool
+    {
+        return lhs.Code < rhs.Code;
+    });
+
+    std::vector<int> codes;
+    codes.reserve(children.size());
+    for (const auto& child : children)
+    {
+        codes.push_back(child.Code);
+    }
+
+    const auto base = FindBase(codes, nextCheckPosition);
+    _units[state].Base = base;
+
+    // Claim all the children before going down, so the subtrees can not take their units.
+    for (const auto& child : children)
+    {
+        _units[base + child.Code].Check = state;
+    }
+
+    for (const auto& child : children)
+    {
+        Place(keys, child.Begin, child.End, depth + 1, base + child.Code, nextCheckPosition);
+    }
+}
+
+
+inline int DoubleArrayTrie::FindBase(const std::vector<int>& codes, int& nextCheckPosition)
+{
+    auto position = std::max(codes.front() + 1, nextCheckPosition) - 1;
+    auto occupied = 0;
+    auto firstFree = true;
+    int base;
+
+    while (true)
+    {
+        position++;
+        Reserve(position);
+
+        if (_units[position].Check != -1)
+        {
+            occupied++;
+            continue;
+        }
+
+        if (firstFree)
+        {
+            nextCheckPosition = position;
+            firstFree = false;
+        }
+
+        base = position - codes.front();
+        Reserve(base + codes.back());
+
+        auto fits = true;
+        for (auto i = 1; i < static_cast<int>(codes.size()); i++)
+        {
+            if (_units[base + codes[i]].Check != -1)
+            {
+                fits = false;
+                break;
+            }
+        }
+
+        if (fits)
+        {
+            break;
+        }
+    }
+
+    // The range before position is almost full, do not scan it again.
+    if (occupied >= 0.95 * (position - nextCheckPosition + 1))
+    {
+        nextCheckPosition = position;
+    }
+
+    return base;
+}
+
+
+inline void DoubleArrayTrie::Reserve(const int position)
+{
+    if (position >= static_cast<int>(_units.size()))
+    {
+        _units.resize(std::max(position + 1, static_cast<int>(_units.size()) * 2));
+    }
+}
+
+
+#endif //DATASTRUCTUREPROJECT_DOUBLEARRAYTRIE_HPP
@@ -0,0 +1,283 @@
+//
+// Created on 2026/10/16 at 22:35.
+//
+
+#ifndef DATASTRUCTUREPROJECT_EXTRACTIONPLAN_HPP
+#define DATASTRUCTUREPROJECT_EXTRACTIONPLAN_HPP
+
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include "CharString.hpp"
+#include "CharStringList.hpp"
+#include "StringBuilder.hpp"
+#include "XmlNode.hpp"
+#include "XmlNodeIndex.hpp"
+#include "XmlParser.hpp"
+#include "HtmlTokenizer.hpp"
+#include "HtmlRegionMatcher.hpp"
+#include "HtmlEntity.hpp"
+
+
+/// \brief The fields to extract from a page and how to locate each of them, built once for a site template.
+/// \note Each rule locates a field the same way: find the elements with an attribute in document order,
+/// take one of them as the anchor, then follow a path of child indexes from it. The content of the field
+/// is all the texts inside, except those in some ignored tags. A plan is executed on a whole page at once,
+/// either in one scan of the HTML file or in one walk of its xml tree.
+class ExtractionPlan
+{
+public:
+    enum class Field
+    {
+        BigCategory,
+        SmallCategory,
+        PostTitle,
+        PostContent,
+        PostAuthor,
+        PostDate,
+        PostType
+    };
+
+    static const int FieldCount = 7;
+
+    class Rule
+    {
+    public:
+        Field Target;
+
+        /// \brief The attribute of the anchor as written in the tag, e.g. <code>class="t_f"</code>.
+        CharString Attribute;
+
+        /// \brief Which of the elements with the attribute is the anchor, starting from 0.
+        int Occurrence;
+
+        /// \brief The indexes of the children leading from the anchor to the field, starting from 0.
+        std::vector<int> Path;
+
+        /// \brief Texts in the elements with these names are not extracted.
+        std::vector<CharString> IgnoringTags;
+
+        /// \brief Whether to decode the character references in the content.
+        bool DecodesEntities;
+    };
+
+    /// \brief All the fields extracted from a page.
+    class Record
+    {
+        friend class ExtractionPlan;
+    public:
+        /// \brief Test if a field was found in the page.
+        bool IsFound(Field field) const;
+
+        /// \brief Get the content of a field.
+        /// \throw std::logic_error if the field was not found.
+        const CharString& Get(Field field) const;
+
+    private:
+        CharString _values[FieldCount];
+        bool _isFound[FieldCount] = {};
+    };
+
+    /// \brief Add a rule to the plan, a later rule for the same field replaces the value of an earlier one.
+    /// \param target The field the rule extracts.
+    /// \param attribute The attribute of the anchor as written in the tag.
+    /// \param occurrence Which of the elements with the attribute is the anchor, starting from 0.
+    /// \param path The indexes of the children leading from the anchor to the field, starting from 0.
+    /// \param ignoringTags Texts in the elements with these names are not extracted.
+    /// \param decodesEntities Whether to decode the character references in the content.
+    void AddRule(Field target, const CharString& attribute, int occurrence, const std::vector<int>& path,
+                 const std::vector<CharString>& ignoringTags = std::vector<CharString>(),
+                 bool decodesEntities = false);
+
+    /// \brief Extract all the fields from a HTML file in one scan with <code>HtmlTokenizer</code>.
+    /// \param html Content of the HTML file.
+    /// \return The extracted fields.
+    Record Execute(const CharString& html) const;
+
+    /// \brief Extract all the fields from a xml tree.
+    /// \param root The pseudo root of the tree.
+    /// \param index The index filled when parsing the tree, nullptr to walk the tree once instead.
+    /// \return The extracted fields.
+    Record Execute(XmlNode* root, XmlNodeIndex* index = nullptr) const;
+
+    /// \brief Get the plan of the threads of <a href="http://bbs.cehome.com/">cehome bbs</a>.
+    static const ExtractionPlan& GetThreadPlan();
+
+private:
+    std::vector<Rule> _rules;
+
+    /// \brief Find the anchors of all the rules in one walk, stopping once all of them are found.
+    /// \param root The node to walk from.
+    /// \param anchors The anchor of each rule, nullptr if not found.
+    void FindAnchors(XmlNode* root, std::vector<XmlNode *>& anchors) const;
+
+    /// \brief Follow a path of child indexes.
+    /// \return The node at the end, nullptr if the path leads out of the tree.
+    static XmlNode* Navigate(XmlNode* node, const std::vector<int>& path);
+};
+
+
+inline bool ExtractionPlan::Record::IsFound(const Field field) const
+{
+    return _isFound[static_cast<int>(field)];
+}
+
+
+inline const CharString& ExtractionPlan::Record::Get(const Field field) const
+{
+    if (!IsFound(field))
+    {
+        throw std::logic_error("Field not found in ExtractionPlan::Record::Get()");
+    }
+
+    return _values[static_cast<int>(field)];
+}
+
+
+inline void ExtractionPlan::AddRule(const Field target, const CharString& attribute, const int occurrence,
+                                    const std::vector<int>& path, const std::vector<CharString>& ignoringTags,
+                                    const bool decodesEntities)
+{
+    _rules.push_back(Rule{target, attribute, occurrence, path, ignoringTags, decodesEntities});
+}
+
+
+inline ExtractionPlan::Record ExtractionPlan::Execute(const CharString& html) const
+{
+    HtmlRegionMatcher matcher;
+    for (const auto& rule : _rules)
+    {
+        matcher.AddRegion(rule.Attribute, rule.Occurrence, rule.Path, rule.IgnoringTags, rule.DecodesEntities);
+    }
+
+    HtmlTokenizer::Tokenize(html, matcher);
+
+    Record record;
+    for (auto i = 0; i < static_cast<int>(_rules.size()); i++)
+    {
+        if (matcher.IsFound(i))
+        {
+            const auto field = static_cast<int>(_rules[i].Target);
+            record._values[field] = matcher.TakeContent(i);
+            record._isFound[field] = true;
+        }
+    }
+
+    return record;
+}
+
+
+inline ExtractionPlan::Record ExtractionPlan::Execute(XmlNode* root, XmlNodeIndex* index) const
+{
+    std::vector<XmlNode *> anchors(_rules.size(), nullptr);
+    if (index != nullptr)
+    {
+        for (auto i = 0; i < static_cast<int>(_rules.size()); i++)
+        {
+            anchors[i] = index->GetElementByAttribution(_rules[i].Attribute, _rules[i].Occurrence);
+        }
+    }
+    else
+    {
+        FindAnchors(root, anchors);
+    }
+
+    Record record;
+    for (auto i = 0; i < static_cast<int>(_rules.size()); i++)
+    {
+        const auto& rule = _rules[i];
+        const auto node = anchors[i] == nullptr ? nullptr : Navigate(anchors[i], rule.Path);
+        if (node == nullptr)
+        {
+            continue;
+        }
+
+        CharStringList ignoringTags;
+        for (const auto& tag : rule.IgnoringTags)
+        {
+            ignoringTags.Append(tag);
+        }
+
+        StringBuilder content;
+        XmlParser::AppendContent(node, ignoringTags, content);
+        if (rule.DecodesEntities)
+        {
+            content.Truncate(HtmlEntity::Decode(content.GetData(), content.GetLength()));
+        }
+
+        const auto field = static_cast<int>(rule.Target);
+        record._values[field] = content.ToCharString();
+        record._isFound[field] = true;
+    }
+
+    return record;
+}
+
+
+inline const ExtractionPlan& ExtractionPlan::GetThreadPlan()
+{
+    static const auto plan = []
+    {
+        ExtractionPlan ret;
+        ret.AddRule(Field::BigCategory, CharString(std::wstring(L"id=\"pt\"")), 0, {0, 4});
+        ret.AddRule(Field::SmallCategory, CharString(std::wstring(L"id=\"pt\"")), 0, {0, 6});
+        ret.AddRule(Field::PostTitle, CharString(std::wstring(L"id=\"thread_subject\"")), 0, {0});
+
+        // Some of the contents are encoded as HTML, need to decode them.
+        ret.AddRule(Field::PostContent, CharString(std::wstring(L"class=\"t_f\"")), 0, {},
+                    {CharString(std::wstring(L"ignore_js_op"))}, true);
+
+        ret.AddRule(Field::PostAuthor, CharString(std::wstring(L"class=\"authi\"")), 0, {0});
+        ret.AddRule(Field::PostDate, CharString(std::wstring(L"class=\"authi\"")), 1, {0});
+        ret.AddRule(Field::PostType, CharString(std::wstring(L"class=\"ts z h1\"")), 0, {0});
+        return ret;
+    }();
+
+    return plan;
+}
+
+
+inline void ExtractionPlan::FindAnchors(XmlNode* root, std::vector<XmlNode *>& anchors) const
+{
+    // The number of elements with the attribute of each rule met so far.
+    std::vector<int> matched(_rules.size(), 0);
+    auto remaining = static_cast<int>(_rules.size());
+
+    // The nodes are in document order, the walk is a scan of the subtree.
+    const auto end = root + root->GetSubtreeSize();
+    for (auto node = root; node != end && remaining != 0; node++)
+    {
+        if (node->IsCommentNode || node->IsTextNode)
+        {
+            continue;
+        }
+
+        for (auto i = 0; i < static_cast<int>(_rules.size()); i++)
+        {
+            if (anchors[i] == nullptr && node->HasAttribute(_rules[i].Attribute) &&
+                matched[i]++ == _rules[i].Occurrence)
+            {
+                anchors[i] = node;
+                remaining--;
+            }
+        }
+    }
+}
+
+
+inline XmlNode* ExtractionPlan::Navigate(XmlNode* node, const std::vector<int>& path)
+{
+    for (const auto index : path)
+    {
+        node = node->GetChildAt(index);
+        if (node == nullptr)
+        {
+            return nullptr;
+        }
+    }
+
+    return node;
+}
+
+
+#endif //DATASTRUCTUREPROJECT_EXTRACTIONPLAN_HPP
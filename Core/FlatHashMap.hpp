@@ -0,0 +1,545 @@
+//
+// Created on 2026/10/16 at 16:55.
+//
+
+#ifndef DATASTRUCTUREPROJECT_FLATHASHMAP_HPP
+#define DATASTRUCTUREPROJECT_FLATHASHMAP_HPP
+
+#include <new>
+#include <cstring>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include "Simd.hpp"
+
+
+/// \brief A dictionary implemented with an open addressing hash table, probed a group of slots at a time.
+/// \tparam TKey Type of the key.
+/// \tparam TValue Type of the value, need to have a default constructor.
+/// \tparam THash A function returning the hash code of a key, called like <code>hash(key)</code>.
+/// It may hold state, e.g. where the keys are resolved, pass it to the constructor then.
+/// The code is mixed again, so a hash with a small range still spreads over the whole table.
+/// Codes of up to 64 bits are used in full.
+/// \note Each slot has a control byte: empty, deleted, or the low 7 bits of the hash of its key.
+/// A lookup compares a whole group of control bytes with those 7 bits at once,
+/// and only compares the keys of the matching slots. The capacity is a power of two and doubles when
+/// the table is 7/8 full. Inserting may move the entries, which invalidates the iterators.
+template <typename TKey, typename TValue, typename THash>
+class FlatHashMap
+{
+public:
+    /// \brief Insert a record to the dictionary.
+    /// \param key Key of the record.
+    /// \param value Value of the record.
+    /// \note If there is a record with the same key in the dictionary, its value will be overwritten.
+    void Insert(const TKey& key, const TValue& value);
+
+    /// \brief Test if the dictionary has a record with the given key.
+    /// \param key Key to be checked in the instance.
+    /// \return True if the dictionary has a record with the given key, otherwise false.
+    bool Contains(const TKey& key);
+
+    /// \brief Find the value of the record of the key in the dictionary.
+    /// \param key Key of the record.
+    /// \return Value of the record.
+    /// \note If there isn't a record with the key in the dictionary,
+    /// a default value produced by default constructor of <code>TValue</code> will be returned.
+    TValue Search(const TKey& key);
+
+    /// \brief Remove a record from the dictionary.
+    /// \param key Key of the record.
+    /// \note If there isn't a record with the key in the dictionary, nothing will happen.
+    void Remove(const TKey& key);
+
+    void Travelsal(const std::function<void(const TKey&, const TValue&)>& traversalFunction);
+
+    /// \brief Get the number of records.
+    /// \return The number of records.
+    int GetSize() const;
+
+    /// \brief Make room for a number of records, so inserting them will not grow the table.
+    /// \param size The number of records.
+    void Reserve(int size);
+
+    FlatHashMap() = default;
+
+    /// \param hash The function hashing the keys.
+    explicit FlatHashMap(const THash& hash);
+
+    FlatHashMap(const FlatHashMap& rhs);
+    FlatHashMap(FlatHashMap&& rhs) noexcept;
+    FlatHashMap& operator=(const FlatHashMap& rhs);
+    FlatHashMap& operator=(FlatHashMap&& rhs) noexcept;
+    virtual ~FlatHashMap();
+
+private:
+    class MapEntry
+    {
+    public:
+        TKey Key;
+        TValue Value;
+
+
+        MapEntry(const TKey& key, const TValue& value)
+            : Key(key), Value(value)
+        {
+        }
+    };
+
+    static const unsigned char Empty = 0x80;
+    static const unsigned char Deleted = 0xFE;
+
+    /// \brief Control bytes of the slots, followed by a copy of the first group,
+    /// so a group starting near the end can be loaded without wrapping.
+    unsigned char* _control = nullptr;
+
+    /// \brief The slots, only those with a full control byte are constructed.
+    MapEntry* _slots = nullptr;
+
+    /// \brief The number of slots, 0 or a power of two not less than <code>Simd::GroupWidth</code>.
+    int _capacity = 0;
+
+    int _size = 0;
+
+    /// \brief The number of slots that can still be filled before rehashing.
+    int _growthLeft = 0;
+
+    THash _hash;
+
+    /// \brief Mix the hash code, the low 7 bits go to the control byte and the rest choose the first group.
+    template <typename TLookupKey>
+    std::uint64_t GetHash(const TLookupKey& key) const;
+
+    /// \brief Find the slot of a key.
+    /// \return Index of the slot, -1 if not found.
+    template <typename TLookupKey>
+    int Find(const TLookupKey& key) const;
+
+    /// \brief Find the first empty or deleted slot to insert a key with the hash.
+    int FindInsertSlot(std::uint64_t hash) const;
+
+    /// \brief Set a control byte and its copy after the end.
+    void SetControl(int index, unsigned char control);
+
+    /// \brief Move all the records to a new table.
+    /// \param capacity The number of slots of the new table, a power of two.
+    void Rehash(int capacity);
+
+    /// \brief Destroy all the records and free the table.
+    void Release();
+
+    /// \brief Get the largest number of records a table with the capacity holds.
+    static int GetMaxSize(int capacity);
+
+public:
+    class ReadWriteIterator
+    {
+        friend class FlatHashMap;
+    public:
+        TValue& operator*()
+        {
+            return _item->Value;
+        }
+
+        TValue* operator->()
+        {
+            return &(_item->Value);
+        }
+
+        bool operator==(const ReadWriteIterator& rhs)
+        {
+            return _item == rhs._item;
+        }
+
+        bool operator!=(const ReadWriteIterator& rhs)
+        {
+            return _item != rhs._item;
+        }
+
+        explicit ReadWriteIterator(MapEntry* item) : _item(item)
+        {
+        }
+
+    private:
+        MapEntry* _item = nullptr;
+    };
+
+    ReadWriteIterator EmptyIterator()
+    {
+        return ReadWriteIterator(nullptr);
+    }
+
+    /// \brief Locate the element with given key.
+    /// \tparam TLookupKey Type of the key to look up, <code>TKey</code> or any type <code>THash</code> can hash
+    /// to the same code and <code>TKey</code> can be compared equal with, e.g. <code>CharStringView</code>.
+    /// \param key Key of the locating element.
+    /// \return Iterator to the element, EmptyIterator() if not found.
+    template <typename TLookupKey>
+    ReadWriteIterator Locate(const TLookupKey& key);
+};
+
+
+template <typename TKey, typename TValue, typename THash>
+void FlatHashMap<TKey, TValue, THash>::Insert(const TKey& key, const TValue& value)
+{
+    const auto index = Find(key);
+    if (index != -1)
+    {
+        _slots[index].Value = value;
+        return;
+    }
+
+    if (_growthLeft == 0)
+    {
+        // Grow if the table is really full, otherwise only clean the deleted slots.
+        if (_capacity == 0)
+        {
+            Rehash(Simd::GroupWidth);
+        }
+        else
+        {
+            Rehash(_size + 1 > GetMaxSize(_capacity) / 2 ? _capacity * 2 : _capacity);
+        }
+    }
+
+    const auto hash = GetHash(key);
+    const auto inserting = FindInsertSlot(hash);
+
+    if (_control[inserting] == Empty)
+    {
+        _growthLeft--;
+    }
+
+    new(&_slots[inserting]) MapEntry(key, value);
+    SetControl(inserting, static_cast<unsigned char>(hash & 0x7F));
+    _size++;
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+bool FlatHashMap<TKey, TValue, THash>::Contains(const TKey& key)
+{
+    return Find(key) != -1;
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+TValue FlatHashMap<TKey, TValue, THash>::Search(const TKey& key)
+{
+    const auto index = Find(key);
+    if (index == -1)
+    {
+        return TValue();
+    }
+
+    return _slots[index].Value;
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+void FlatHashMap<TKey, TValue, THash>::Remove(const TKey& key)
+{
+    const auto index = Find(key);
+    if (index == -1)
+    {
+        return;
+    }
+
+    _slots[index].~MapEntry();
+    _size--;
+
+    // If every group containing the slot also contains an empty slot, no probe sequence passed through it,
+    // so it can become empty again instead of deleted.
+    const auto before = (index - Simd::GroupWidth) & (_capacity - 1);
+    const auto emptyAfter = Simd::MatchByte(_control + index, Empty);
+    const auto emptyBefore = Simd::MatchByte(_control + before, Empty);
+
+    auto fullBefore = 0;
+    while (emptyBefore != 0 && !(emptyBefore & (1u << (Simd::GroupWidth - 1 - fullBefore))))
+    {
+        fullBefore++;
+    }
+
+    if (emptyBefore != 0 && emptyAfter != 0 &&
+        fullBefore + Simd::CountTrailingZeros(emptyAfter) < Simd::GroupWidth)
+    {
+        SetControl(index, Empty);
+        _growthLeft++;
+    }
+    else
+    {
+        SetControl(index, Deleted);
+    }
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+void FlatHashMap<TKey, TValue, THash>::Travelsal(
+    const std::function<void(const TKey&, const TValue&)>& traversalFunction)
+{
+    for (auto i = 0; i < _capacity; i++)
+    {
+        if (!(_control[i] & 0x80))
+        {
+            traversalFunction(_slots[i].Key, _slots[i].Value);
+        }
+    }
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+int FlatHashMap<TKey, TValue, THash>::GetSize() const
+{
+    return _size;
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+void FlatHashMap<TKey, TValue, THash>::Reserve(const int size)
+{
+    auto capacity = _capacity == 0 ? Simd::GroupWidth : _capacity;
+    while (GetMaxSize(capacity) < size)
+    {
+        capacity *= 2;
+    }
+
+    if (capacity != _capacity)
+    {
+        Rehash(capacity);
+    }
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+FlatHashMap<TKey, TValue, THash>::FlatHashMap(const THash& hash)
+    : _hash(hash)
+{
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+FlatHashMap<TKey, TValue, THash>::FlatHashMap(const FlatHashMap& rhs)
+    : _hash(rhs._hash)
+{
+    (*this) = rhs;
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+FlatHashMap<TKey, TValue, THash>::FlatHashMap(FlatHashMap&& rhs) noexcept
+    : _control(rhs._control), _slots(rhs._slots), _capacity(rhs._capacity), _size(rhs._size),
+      _growthLeft(rhs._growthLeft), _hash(rhs._hash)
+{
+    rhs._control = nullptr;
+    rhs._slots = nullptr;
+    rhs._capacity = 0;
+    rhs._size = 0;
+    rhs._growthLeft = 0;
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+FlatHashMap<TKey, TValue, THash>& FlatHashMap<TKey, TValue, THash>::operator=(const FlatHashMap& rhs)
+{
+    if (this == &rhs)
+    {
+        return *this;
+    }
+
+    Release();
+    _hash = rhs._hash;
+    Reserve(rhs._size);
+
+    for (auto i = 0; i < rhs._capacity; i++)
+    {
+        if (!(rhs._control[i] & 0x80))
+        {
+            Insert(rhs._slots[i].Key, rhs._slots[i].Value);
+        }
+    }
+
+    return *this;
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+FlatHashMap<TKey, TValue, THash>& FlatHashMap<TKey, TValue, THash>::operator=(FlatHashMap&& rhs) noexcept
+{
+    if (this == &rhs)
+    {
+        return *this;
+    }
+
+    Release();
+    std::swap(_control, rhs._control);
+    std::swap(_slots, rhs._slots);
+    std::swap(_capacity, rhs._capacity);
+    std::swap(_size, rhs._size);
+    std::swap(_growthLeft, rhs._growthLeft);
+    std::swap(_hash, rhs._hash);
+
+    return *this;
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+FlatHashMap<TKey, TValue, THash>::~FlatHashMap()
+{
+    Release();
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+template <typename TLookupKey>
+std::uint64_t FlatHashMap<TKey, TValue, THash>::GetHash(const TLookupKey& key) const
+{
+    // Fibonacci hashing, spreads the bits of the code to the high half and folds them back.
+    const auto product = static_cast<std::uint64_t>(_hash(key)) * 0x9E3779B97F4A7C15ull;
+    return product ^ (product >> 32);
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+template <typename TLookupKey>
+int FlatHashMap<TKey, TValue, THash>::Find(const TLookupKey& key) const
+{
+    if (_capacity == 0)
+    {
+        return -1;
+    }
+
+    const auto hash = GetHash(key);
+    const auto control = static_cast<unsigned char>(hash & 0x7F);
+    const auto mask = _capacity - 1;
+
+    // Triangular probing over groups visits every group once when the capacity is a power of two.
+    auto position = static_cast<int>((hash >> 7) & mask);
+    for (auto step = Simd::GroupWidth; ; step += Simd::GroupWidth)
+    {
+        const auto group = _control + position;
+
+        for (auto match = Simd::MatchByte(group, control); match != 0; match &= match - 1)
+        {
+            const auto index = (position + Simd::CountTrailingZeros(match)) & mask;
+            if (_slots[index].Key == key)
+            {
+                return index;
+            }
+        }
+
+        if (Simd::MatchByte(group, Empty) != 0)
+        {
+            return -1;
+        }
+
+        position = (position + step) & mask;
+    }
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+int FlatHashMap<TKey, TValue, THash>::FindInsertSlot(const std::uint64_t hash) const
+{
+    const auto mask = _capacity - 1;
+
+    auto position = static_cast<int>((hash >> 7) & mask);
+    for (auto step = Simd::GroupWidth; ; step += Simd::GroupWidth)
+    {
+        const auto match = Simd::MatchHighBit(_control + position);
+        if (match != 0)
+        {
+            return (position + Simd::CountTrailingZeros(match)) & mask;
+        }
+
+        position = (position + step) & mask;
+    }
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+void FlatHashMap<TKey, TValue, THash>::SetControl(const int index, const unsigned char control)
+{
+    _control[index] = control;
+    if (index < Simd::GroupWidth)
+    {
+        _control[_capacity + index] = control;
+    }
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+void FlatHashMap<TKey, TValue, THash>::Rehash(const int capacity)
+{
+    const auto oldControl = _control;
+    const auto oldSlots = _slots;
+    const auto oldCapacity = _capacity;
+
+    _capacity = capacity;
+    _control = new unsigned char[capacity + Simd::GroupWidth];
+    std::memset(_control, Empty, capacity + Simd::GroupWidth);
+    _slots = static_cast<MapEntry*>(::operator new(sizeof(MapEntry) * capacity));
+    _growthLeft = GetMaxSize(capacity) - _size;
+
+    for (auto i = 0; i < oldCapacity; i++)
+    {
+        if (!(oldControl[i] & 0x80))
+        {
+            const auto hash = GetHash(oldSlots[i].Key);
+            const auto inserting = FindInsertSlot(hash);
+
+            new(&_slots[inserting]) MapEntry(std::move(oldSlots[i]));
+            SetControl(inserting, static_cast<unsigned char>(hash & 0x7F));
+            oldSlots[i].~MapEntry();
+        }
+    }
+
+    delete[] oldControl;
+    ::operator delete(oldSlots);
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+void FlatHashMap<TKey, TValue, THash>::Release()
+{
+    for (auto i = 0; i < _capacity; i++)
+    {
+        if (!(_control[i] & 0x80))
+        {
+            _slots[i].~MapEntry();
+        }
+    }
+
+    delete[] _control;
+    ::operator delete(_slots);
+
+    _control = nullptr;
+    _slots = nullptr;
+    _capacity = 0;
+    _size = 0;
+    _growthLeft = 0;
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+int FlatHashMap<TKey, TValue, THash>::GetMaxSize(const int capacity)
+{
+    return capacity - capacity / 8;
+}
+
+
+template <typename TKey, typename TValue, typename THash>
+template <typename TLookupKey>
+typename FlatHashMap<TKey, TValue, THash>::ReadWriteIterator
+FlatHashMap<TKey, TValue, THash>::Locate(const TLookupKey& key)
+{
+    const auto index = Find(key);
+    if (index == -1)
+    {
+        return EmptyIterator();
+    }
+
+    return ReadWriteIterator(&_slots[index]);
+}
+
+
+#endif //DATASTRUCTUREPROJECT_FLATHASHMAP_HPP
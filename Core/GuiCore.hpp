@@ -1,7 +1,6 @@
 #pragma once
 
 #include <iostream>
-#include <locale>
 #include <fstream>
 #include <iomanip>
 #include <omp.h>
@@ -11,7 +10,12 @@
 #include "Dictionary.hpp"
 #include "Document.hpp"
 #include "AvlTreeInvertedIndex.hpp"
+#include "InvertedIndexShards.hpp"
+#include "IndexFile.hpp"
 #include "CsvUtility.hpp"
+#include "Transcoder.hpp"
+#include "AhoCorasickMatcher.hpp"
+#include <vcclr.h>
 
 public ref class GuiCore
 {
@@ -28,6 +32,11 @@ public:
 
     System::Collections::Generic::Dictionary<int, int>^ Query(System::String^ query);
 
+    /// \brief Get the best k documents for the query, ranked by BM25.
+    /// \return Pairs of document id and score, in descending order of score.
+    System::Collections::Generic::List<System::Collections::Generic::KeyValuePair<int, double>>^ QueryTopK(
+        System::String^ query, int k);
+
     GuiCore();
     ~GuiCore();
     !GuiCore();
@@ -38,11 +47,45 @@ public:
     System::String^ GetPostTitle(int documentId);
     System::String^ GetPostContent(int documentId);
 
+    /// \brief Get the parts of a text covered by the words of a query, for highlighting.
+    /// \return Pairs of start and length, in ascending order.
+    /// \note All the words are found in one scan. The query is compiled once and kept until another one is given,
+    /// the text is searched in place.
+    System::Collections::Generic::List<System::Collections::Generic::KeyValuePair<int, int>>^ Highlight(
+        System::String^ text, System::String^ query);
+
+    /// \brief Get the part of a text best covering the words of a query, see <code>AhoCorasickMatcher::GetSnippet</code>.
+    /// \param width The number of characters of the snippet.
+    System::String^ GetSnippet(System::String^ text, System::String^ query, int width);
+
+    /// \brief Save the index built by <code>ProcessUrls</code> to a file.
+    void SaveIndex(System::String^ path);
+
+    /// \brief Load an index file saved by <code>SaveIndex</code>, queries will be answered from it.
+    /// \return If the index file is loaded.
+    bool LoadIndex(System::String^ path);
+
 private:
+    /// \brief Split a query from the GUI to a list of words.
+    static CharStringList SplitQuery(System::String^ query);
+
+    /// \brief Convert a path from the GUI to a narrow string.
+    static std::string ToStdString(System::String^ path);
+
     Dictionary* _dictionary = nullptr;
     AvlTreeInvertedIndex* _invertedIndex = nullptr;
 
+    /// \brief The loaded index file, nullptr if the index is built in memory.
+    MappedInvertedIndex* _mappedIndex = nullptr;
+
     AvlTree<int, Document*, std::less<int>>* _allDocuments = nullptr;
+
+    /// \brief The matcher of the words of <code>_highlightQuery</code>, nullptr before the first highlight.
+    AhoCorasickMatcher* _highlighter = nullptr;
+    System::String^ _highlightQuery = nullptr;
+
+    /// \brief Get the matcher of a query, compile it if the query differs from the last one.
+    AhoCorasickMatcher* GetHighlighter(System::String^ query);
 };
 
 GuiCore::GuiCore()
@@ -54,6 +97,9 @@ GuiCore::GuiCore()
 
 inline GuiCore::!GuiCore()
 {
+    delete _mappedIndex;
+    _mappedIndex = nullptr;
+
     delete _dictionary;
     _dictionary = nullptr;
 
@@ -62,20 +108,91 @@ inline GuiCore::!GuiCore()
 
     delete _allDocuments;
     _allDocuments = nullptr;
+
+    delete _highlighter;
+    _highlighter = nullptr;
 }
 
 inline System::String ^ GuiCore::GetPostTitle(int documentId)
 {
+    if (_mappedIndex != nullptr)
+    {
+        return gcnew System::String(_mappedIndex->GetPostTitle(documentId).ToStdWstring().c_str());
+    }
+
     return gcnew System::String(_allDocuments->Search(documentId)->PostTitle.ToStdWstring().c_str());   
 }
 
 inline System::String ^ GuiCore::GetPostContent(int documentId)
 {
+    if (_mappedIndex != nullptr)
+    {
+        return gcnew System::String(_mappedIndex->GetPostContent(documentId).ToStdWstring().c_str());
+    }
+
     return gcnew System::String(_allDocuments->Search(documentId)->PostContent.ToStdWstring().c_str());
 }
 
+inline System::Collections::Generic::List<System::Collections::Generic::KeyValuePair<int, int>>^ GuiCore::Highlight(
+    System::String^ text, System::String^ query)
+{
+    using Span = System::Collections::Generic::KeyValuePair<int, int>;
+    auto spans = gcnew System::Collections::Generic::List<Span>();
+    if (System::String::IsNullOrEmpty(text))
+    {
+        return spans;
+    }
+
+    const auto highlighter = GetHighlighter(query);
+    const pin_ptr<const wchar_t> chars = PtrToStringChars(text);
+    for (const auto& span : highlighter->GetHighlights(CharStringView(chars, text->Length)))
+    {
+        spans->Add(Span(span.Start, span.Length));
+    }
+
+    return spans;
+}
+
+inline System::String^ GuiCore::GetSnippet(System::String^ text, System::String^ query, int width)
+{
+    if (System::String::IsNullOrEmpty(text))
+    {
+        return System::String::Empty;
+    }
+
+    const auto highlighter = GetHighlighter(query);
+    const pin_ptr<const wchar_t> chars = PtrToStringChars(text);
+    const auto snippet = highlighter->GetSnippet(CharStringView(chars, text->Length), width);
+
+    return text->Substring(snippet.Start, snippet.Length);
+}
+
+inline AhoCorasickMatcher* GuiCore::GetHighlighter(System::String^ query)
+{
+    if (_highlighter != nullptr && System::String::Equals(query, _highlightQuery))
+    {
+        return _highlighter;
+    }
+
+    std::vector<CharString> words;
+    std::function<void(const CharString&)> append = [&words](const CharString& word) -> void
+    {
+        words.push_back(word);
+    };
+    SplitQuery(query == nullptr ? System::String::Empty : query).Iterate(append);
+
+    delete _highlighter;
+    _highlighter = new AhoCorasickMatcher(words);
+    _highlightQuery = query;
+
+    return _highlighter;
+}
+
 inline GuiCore::~GuiCore()
 {
+    delete _mappedIndex;
+    _mappedIndex = nullptr;
+
     delete _dictionary;
     _dictionary = nullptr;
 
@@ -84,6 +201,9 @@ inline GuiCore::~GuiCore()
 
     delete _allDocuments;
     _allDocuments = nullptr;
+
+    delete _highlighter;
+    _highlighter = nullptr;
 }
 
 inline void GuiCore::InitializeDictionary()
@@ -95,25 +215,26 @@ inline void GuiCore::InitializeDictionary()
 
 inline void GuiCore::ProcessUrls()
 {
-    std::wifstream fin;
-    std::wstring finReader;
-    fin.imbue(std::locale("chs"));
-    fin.open(L"./url.csv");
-
-    getline(fin, finReader);
-
-    std::vector<std::wstring> urls;
-    urls.reserve(2000);
-
-    while (getline(fin, finReader, L'\n'))
+    // The first line is the header.
+    auto urls = Transcoder::ReadLines("./url.csv", Transcoder::Encoding::Gb18030);
+    if (!urls.empty())
     {
-        urls.push_back(finReader);
+        urls.erase(urls.begin());
     }
 
     const auto size = urls.size();
+    const auto threadCount = 64;
+
+    // Each thread indexes into its own shard, the first shard is the final index.
+    std::vector<AvlTreeInvertedIndex*> shards(threadCount);
+    shards[0] = _invertedIndex;
+    for (auto i = 1; i < threadCount; i++)
+    {
+        shards[i] = new AvlTreeInvertedIndex();
+    }
 
     auto progressCount = 0;
-#pragma omp parallel for num_threads(64)
+#pragma omp parallel for num_threads(threadCount)
     for (auto i = 0; i < static_cast<int>(size); i++)
     {
         // Parse this line.
@@ -121,8 +242,8 @@ inline void GuiCore::ProcessUrls()
         auto list = CsvUtility::CsvDecode(cs);
 
         const auto id = stoi(list.GetItemAt(0).ToStdWstring());
-        auto url = list.GetItemAt(1);
-        url = url.GetSubstring(1, url.GetLength() - 1);
+        const auto& quotedUrl = list.GetItemAt(1);
+        const auto url = quotedUrl.GetSubview(1, quotedUrl.GetLength() - 1);
 
         auto document = new Document();
 
@@ -149,21 +270,15 @@ inline void GuiCore::ProcessUrls()
             ParsingProgressReport(static_cast<double>(progressCount) / static_cast<double>(size));
         }
 
-        auto& wordList = document->Words;
-        AvlTree<CharString, int, std::less<CharString>> countedWords;
+        auto& shard = *shards[omp_get_thread_num()];
+        shard.AddDocument(document);
+    }
 
-        for (const auto& word : wordList)
-        {
-            if (!countedWords.Contains(word))
-            {
-                countedWords.Insert(word, 0);
-                const auto increase = document->CountWords(word);
-#pragma omp critical
-                {
-                    _invertedIndex->AddOccurrence(word, document, increase);
-                }
-            }
-        }
+    InvertedIndexShards::Reduce(shards);
+
+    for (auto i = 1; i < threadCount; i++)
+    {
+        delete shards[i];
     }
 }
 
@@ -173,7 +288,42 @@ inline void GuiCore::DestroyDictionary()
     _dictionary = nullptr;
 }
 
-inline System::Collections::Generic::Dictionary<int, int>^ GuiCore::Query(System::String ^ query)
+inline void GuiCore::SaveIndex(System::String^ path)
+{
+    std::vector<const Document*> documents;
+    _allDocuments->InorderTraversal([&documents](const int&, Document* const& document)-> void
+    {
+        documents.push_back(document);
+    });
+
+    IndexFile::Save(ToStdString(path), *_invertedIndex, documents);
+}
+
+inline bool GuiCore::LoadIndex(System::String^ path)
+{
+    try
+    {
+        auto mappedIndex = new MappedInvertedIndex(ToStdString(path));
+        delete _mappedIndex;
+        _mappedIndex = mappedIndex;
+        return true;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+inline std::string GuiCore::ToStdString(System::String^ path)
+{
+    using namespace System::Runtime::InteropServices;
+    auto chars = (const char*)(Marshal::StringToHGlobalAnsi(path)).ToPointer();
+    std::string ret(chars);
+    Marshal::FreeHGlobal(System::IntPtr((void*)chars));
+    return ret;
+}
+
+inline CharStringList GuiCore::SplitQuery(System::String^ query)
 {
     auto list = query->Split(gcnew array<wchar_t>{L' '}, System::StringSplitOptions::RemoveEmptyEntries);
     std::vector<std::wstring> queries;
@@ -194,7 +344,16 @@ inline System::Collections::Generic::Dictionary<int, int>^ GuiCore::Query(System
         charStringList.Append(charString);
     }
 
-    auto result = _invertedIndex->Query(charStringList);
+    return charStringList;
+}
+
+inline System::Collections::Generic::Dictionary<int, int>^ GuiCore::Query(System::String ^ query)
+{
+    const auto charStringList = SplitQuery(query);
+
+    auto result = _mappedIndex != nullptr
+                      ? _mappedIndex->Query(charStringList)
+                      : _invertedIndex->Query(charStringList);
     auto ret = gcnew System::Collections::Generic::Dictionary<int, int>();
     for (const auto& i : result)
     {
@@ -203,3 +362,20 @@ inline System::Collections::Generic::Dictionary<int, int>^ GuiCore::Query(System
 
     return ret;
 }
+
+inline System::Collections::Generic::List<System::Collections::Generic::KeyValuePair<int, double>>^ GuiCore::QueryTopK(
+    System::String^ query, int k)
+{
+    const auto charStringList = SplitQuery(query);
+
+    auto result = _mappedIndex != nullptr
+                      ? _mappedIndex->QueryTopK(charStringList, k)
+                      : _invertedIndex->QueryTopK(charStringList, k);
+    auto ret = gcnew System::Collections::Generic::List<System::Collections::Generic::KeyValuePair<int, double>>();
+    for (const auto& i : result)
+    {
+        ret->Add(System::Collections::Generic::KeyValuePair<int, double>(i.first, i.second));
+    }
+
+    return ret;
+}
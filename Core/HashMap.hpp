@@ -7,8 +7,11 @@
 
 #include "LinkedList.hpp"
 #include <array>
+#include <cstdint>
 
 
+/// \brief A dictionary implemented with a hash table of <code>THashMax - THashMin</code> buckets.
+/// \note <code>THash</code> may return any hash code, it is reduced to the number of buckets.
 template <typename TKey, typename TValue, typename THash, int THashMin, int THashMax>
 class HashMap
 {
@@ -55,6 +58,10 @@ private:
 
 
     LinkedList<MapEntry>* _hashTable = new LinkedList<MapEntry>[THashMax - THashMin];
+
+    /// \brief Get the bucket of a key.
+    template <typename TLookupKey>
+    static int GetBucket(const TLookupKey& key);
 public:
     class ReadWriteIterator
     {
@@ -93,14 +100,20 @@ public:
         return ReadWriteIterator(nullptr);
     }
 
-    ReadWriteIterator Locate(const TKey& key);
+    /// \brief Locate the element with given key.
+    /// \tparam TLookupKey Type of the key to look up, <code>TKey</code> or any type <code>THash</code> can hash
+    /// to the same code and <code>TKey</code> can be compared equal with, e.g. <code>CharStringView</code>.
+    /// \param key Key of the locating element.
+    /// \return Iterator to the element, EmptyIterator() if not found.
+    template <typename TLookupKey>
+    ReadWriteIterator Locate(const TLookupKey& key);
 };
 
 
 template <typename TKey, typename TValue, typename THash, int THashMin, int THashMax>
 void HashMap<TKey, TValue, THash, THashMin, THashMax>::Insert(const TKey& key, const TValue& value)
 {
-    auto hash = THash()(key);
+    const auto bucket = GetBucket(key);
 
     std::function<bool(const MapEntry&)> equal = [&key](const MapEntry& entry) -> bool
     {
@@ -109,12 +122,12 @@ void HashMap<TKey, TValue, THash, THashMin, THashMax>::Insert(const TKey& key, c
 
     try
     {
-        auto result = _hashTable[hash].GetFirstOf(equal);
+        auto result = _hashTable[bucket].GetFirstOf(equal);
         result.Value = value;
     }
     catch (std::logic_error error)
     {
-        _hashTable[hash].Append(MapEntry(key, value));
+        _hashTable[bucket].Append(MapEntry(key, value));
     }
 }
 
@@ -122,30 +135,30 @@ void HashMap<TKey, TValue, THash, THashMin, THashMax>::Insert(const TKey& key, c
 template <typename TKey, typename TValue, typename THash, int THashMin, int THashMax>
 bool HashMap<TKey, TValue, THash, THashMin, THashMax>::Contains(const TKey& key)
 {
-    auto hash = THash()(key);
+    const auto bucket = GetBucket(key);
 
     std::function<bool(const MapEntry&)> equal = [&key](const MapEntry& entry) -> bool
     {
         return entry.Key == key;
     };
 
-    return _hashTable[hash].ContainsIf(equal);
+    return _hashTable[bucket].ContainsIf(equal);
 }
 
 
 template <typename TKey, typename TValue, typename THash, int THashMin, int THashMax>
 TValue HashMap<TKey, TValue, THash, THashMin, THashMax>::Search(const TKey& key)
 {
-    auto hash = THash()(key);
+    const auto bucket = GetBucket(key);
 
-    auto equal = [&key](const MapEntry& entry) -> bool
+    std::function<bool(const MapEntry&)> equal = [&key](const MapEntry& entry) -> bool
     {
         return entry.Key == key;
     };
 
     try
     {
-        auto result = _hashTable[hash].GetFirstOf(equal);
+        auto result = _hashTable[bucket].GetFirstOf(equal);
         return result.Value;
     }
     catch (std::logic_error error)
@@ -158,14 +171,14 @@ TValue HashMap<TKey, TValue, THash, THashMin, THashMax>::Search(const TKey& key)
 template <typename TKey, typename TValue, typename THash, int THashMin, int THashMax>
 void HashMap<TKey, TValue, THash, THashMin, THashMax>::Remove(const TKey& key)
 {
-    auto hash = THash()(key);
+    const auto bucket = GetBucket(key);
 
-    auto equal = [&key](const MapEntry& entry) -> bool
+    std::function<bool(const MapEntry&)> equal = [&key](const MapEntry& entry) -> bool
     {
         return entry.Key == key;
     };
 
-    _hashTable[hash].RemoveFirstOf(equal);
+    _hashTable[bucket].RemoveFirstOf(equal);
 }
 
 
@@ -191,10 +204,11 @@ void HashMap<TKey, TValue, THash, THashMin, THashMax>::Travelsal(
 }
 
 template <typename TKey, typename TValue, typename THash, int THashMin, int THashMax>
+template <typename TLookupKey>
 typename HashMap<TKey, TValue, THash, THashMin, THashMax>::ReadWriteIterator
-HashMap<TKey, TValue, THash, THashMin, THashMax>::Locate(const TKey& key)
+HashMap<TKey, TValue, THash, THashMin, THashMax>::Locate(const TLookupKey& key)
 {
-    auto hash = THash()(key);
+    const auto bucket = GetBucket(key);
 
     try
     {
@@ -203,7 +217,7 @@ HashMap<TKey, TValue, THash, THashMin, THashMax>::Locate(const TKey& key)
             return entry.Key == key;
         };
 
-        const auto& result = _hashTable[hash].GetFirstOf(equal);
+        const auto& result = _hashTable[bucket].GetFirstOf(equal);
 
         return ReadWriteIterator(const_cast<MapEntry*>(&result));
     }
@@ -214,4 +228,12 @@ HashMap<TKey, TValue, THash, THashMin, THashMax>::Locate(const TKey& key)
 }
 
 
+template <typename TKey, typename TValue, typename THash, int THashMin, int THashMax>
+template <typename TLookupKey>
+int HashMap<TKey, TValue, THash, THashMin, THashMax>::GetBucket(const TLookupKey& key)
+{
+    return static_cast<int>(static_cast<std::uint64_t>(THash()(key)) % (THashMax - THashMin));
+}
+
+
 #endif //DATASTRUCTUREPROJECT_HASHMAP_HPP
@@ -4,43 +4,68 @@
 
 #ifndef DATASTRUCTUREPROJECT_HASHMAPINVERTEDINDEX_HPP
 #define DATASTRUCTUREPROJECT_HASHMAPINVERTEDINDEX_HPP
-#include "HashMap.hpp"
+#include "FlatHashMap.hpp"
 #include "CharString.hpp"
+#include "Utf8String.hpp"
+#include "TermTable.hpp"
 #include "InvertedIndexNode.hpp"
+#include "DocumentStatistics.hpp"
+#include "TopKQueryEngine.hpp"
 
 
 class HashMapInvertedIndex
 {
 public:
-    HashMap<CharString, InvertedIndexNode, CharString::Hasher, CharString::HashMin, CharString::HashMax> Core;
+    /// \brief The indexed words, keyed by their term ids in <code>TermTable::GetGlobal()</code>.
+    FlatHashMap<std::uint32_t, InvertedIndexNode, TermTable::Hasher> Core;
 
-    void AddOccurrence(const CharString& word, Document* document, const int times);
+    /// \brief Lengths of the indexed documents.
+    DocumentStatistics Documents;
+
+    /// \brief Index all the words of a document from its term frequency table,
+    /// and record its length, used by <code>QueryTopK</code>.
+    /// \param document The document, each document should only be added once.
+    void AddDocument(const Document* document);
+
+    void AddOccurrence(std::uint32_t termId, const Document* document, const int times);
+
+    /// \brief Merge another index built over a disjoint set of documents into the instance.
+    /// \param rhs The index to merge from. It is not modified.
+    void Merge(HashMapInvertedIndex& rhs);
+
+    /// \brief Call a function on each indexed word and its node.
+    /// \param visitFunction The function to be called on each word.
+    void Iterate(const std::function<void(const Utf8String&, const InvertedIndexNode&)>& visitFunction);
+
+    /// \brief Get the best k documents for the query, ranked by BM25.
+    /// \param queryList The words in the query, they are looked up in the term table once.
+    /// \param k The number of documents to return.
+    /// \return Pairs of document id and score, in descending order of score.
+    LinkedList<std::pair<int, double>> QueryTopK(const CharStringList& queryList, int k);
 
     class IntHasher
     {
     public:
         int operator()(const int i) const
         {
-            return i % (HashMax - HashMin);
+            return i;
         }
-
-        static const int HashMax = 100000;
-        static const int HashMin = 0;
     };
 
-    HashMap<int, int, IntHasher, IntHasher::HashMin, IntHasher::HashMax> Query(const CharStringList& queryList);
+    FlatHashMap<int, int, IntHasher> Query(const CharStringList& queryList);
 };
 
 
-inline void HashMapInvertedIndex::AddOccurrence(const CharString& word, Document* document, const int times)
+inline void HashMapInvertedIndex::AddOccurrence(const std::uint32_t termId, const Document* document,
+                                                const int times)
 {
-    auto location = Core.Locate(word);
+    auto location = Core.Locate(termId);
 
     if (location == Core.EmptyIterator())
     {
-        InvertedIndexNode insertingNode(word);
+        InvertedIndexNode insertingNode(termId);
         insertingNode.AddOccurrence(document, times);
-        Core.Insert(word, insertingNode);
+        Core.Insert(termId, insertingNode);
     }
     else
     {
@@ -48,21 +73,67 @@ inline void HashMapInvertedIndex::AddOccurrence(const CharString& word, Document
     }
 }
 
-inline HashMap<int, int, HashMapInvertedIndex::IntHasher, HashMapInvertedIndex::IntHasher::HashMin, HashMapInvertedIndex
-               ::IntHasher::HashMax> HashMapInvertedIndex::Query(const CharStringList& queryList)
+inline void HashMapInvertedIndex::AddDocument(const Document* document)
+{
+    Documents.Add(document->Id, static_cast<int>(document->Words.size()));
+
+    for (const auto& item : document->GetTermFrequencies())
+    {
+        AddOccurrence(item.first, document, item.second);
+    }
+}
+
+inline void HashMapInvertedIndex::Iterate(
+    const std::function<void(const Utf8String&, const InvertedIndexNode&)>& visitFunction)
+{
+    const auto& terms = TermTable::GetGlobal();
+    Core.Travelsal([&terms, &visitFunction](const std::uint32_t& termId, const InvertedIndexNode& node)-> void
+    {
+        visitFunction(terms.GetWord(termId), node);
+    });
+}
+
+inline void HashMapInvertedIndex::Merge(HashMapInvertedIndex& rhs)
+{
+    Documents.Merge(rhs.Documents);
+
+    rhs.Core.Travelsal([this](const std::uint32_t& termId, const InvertedIndexNode& node)-> void
+    {
+        auto location = Core.Locate(termId);
+
+        if (location == Core.EmptyIterator())
+        {
+            Core.Insert(termId, node);
+        }
+        else
+        {
+            location->Merge(node);
+        }
+    });
+}
+
+inline FlatHashMap<int, int, HashMapInvertedIndex::IntHasher> HashMapInvertedIndex::Query(
+    const CharStringList& queryList)
 {
-    HashMap<int, int, IntHasher, IntHasher::HashMin, IntHasher::HashMax> results;
+    FlatHashMap<int, int, IntHasher> results;
+    const auto& terms = TermTable::GetGlobal();
 
     for (const auto& item : queryList)
     {
-        auto location = Core.Locate(item);
+        std::uint32_t termId;
+        if (!terms.Find(item, termId))
+        {
+            continue;
+        }
+
+        auto location = Core.Locate(termId);
 
         if (location != Core.EmptyIterator())
         {
             for (const auto& documentOccurrence : location->DocumentOccurrenceList)
             {
-                auto documentId = documentOccurrence.first->Id;
-                auto occurrence = documentOccurrence.second;
+                auto documentId = documentOccurrence.DocumentId;
+                auto occurrence = documentOccurrence.Frequency;
                 auto idLocation = results.Locate(documentId);
 
                 if (idLocation != results.EmptyIterator())
@@ -79,4 +150,37 @@ inline HashMap<int, int, HashMapInvertedIndex::IntHasher, HashMapInvertedIndex::
 
     return results;
 }
+
+inline LinkedList<std::pair<int, double>> HashMapInvertedIndex::QueryTopK(const CharStringList& queryList, const int k)
+{
+    std::vector<TermCursor> cursors;
+    std::vector<const InvertedIndexNode*> visited;
+    const auto& terms = TermTable::GetGlobal();
+
+    for (const auto& item : queryList)
+    {
+        std::uint32_t termId;
+        if (!terms.Find(item, termId))
+        {
+            continue;
+        }
+
+        auto location = Core.Locate(termId);
+
+        if (location != Core.EmptyIterator())
+        {
+            const InvertedIndexNode* node = &(*location);
+
+            // Repeated words in the query are scored once.
+            if (std::find(visited.begin(), visited.end(), node) == visited.end())
+            {
+                visited.push_back(node);
+                cursors.push_back(TermCursor(node->DocumentOccurrenceList));
+            }
+        }
+    }
+
+    return TopKQueryEngine::Query(cursors, Documents, k);
+}
+
 #endif //DATASTRUCTUREPROJECT_HASHMAPINVERTEDINDEX_HPP
@@ -0,0 +1,372 @@
+//
+// Created on 2026/10/16 at 18:20.
+//
+
+#ifndef DATASTRUCTUREPROJECT_HTMLREGIONMATCHER_HPP
+#define DATASTRUCTUREPROJECT_HTMLREGIONMATCHER_HPP
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include "CharString.hpp"
+#include "CharStringView.hpp"
+#include "HtmlEntity.hpp"
+#include "StringBuilder.hpp"
+
+
+/// \brief A handler of <code>HtmlTokenizer</code> collecting the texts of some regions of a file in one scan.
+/// \note A region is located the same way as with the xml tree: find the elements with an attribute in document order,
+/// take one of them as the anchor, then follow a path of child indexes from it.
+/// The content of the region is all the texts inside it, like <code>XmlParser::GetContent</code>.
+/// Only the child counts of the open elements and the texts of the unfinished regions are kept during the scan.
+class HtmlRegionMatcher
+{
+public:
+    /// \brief Add a region to collect, call it before scanning.
+    /// \param attribute The attribute of the anchor as written in the tag, e.g. <code>class="t_f"</code>.
+    /// \param occurrence Which of the elements with the attribute is the anchor, starting from 0.
+    /// \param path The indexes of the children leading from the anchor to the region, starting from 0.
+    /// \param ignoringTags Texts in the elements with these names are not collected.
+    /// \param decodesEntities Whether to decode the character references in the texts of the region,
+    /// they are decoded in place while the texts are joined.
+    /// \return Index of the region.
+    int AddRegion(const CharString& attribute, int occurrence, const std::vector<int>& path,
+                  const std::vector<CharString>& ignoringTags = std::vector<CharString>(),
+                  bool decodesEntities = false);
+
+    /// \brief Test if a region was found in the scanned file.
+    /// \param region Index of the region.
+    /// \return True if it was found, otherwise false.
+    bool IsFound(int region) const;
+
+    /// \brief Get the content of a region.
+    /// \param region Index of the region.
+    /// \return All the texts in the region.
+    /// \throw std::logic_error if the region was not found.
+    const CharString& GetContent(int region) const;
+
+    /// \brief Take the content of a region out of the matcher, leaving it empty.
+    /// \param region Index of the region.
+    /// \return All the texts in the region.
+    /// \throw std::logic_error if the region was not found.
+    CharString TakeContent(int region);
+
+    void OnStartElement(const CharStringView& name, const std::vector<CharStringView>& attributes);
+    void OnEndElement(const CharStringView& name);
+    void OnText(const CharStringView& text);
+    void OnComment(const CharStringView& comment);
+
+private:
+    enum class RegionState
+    {
+        /// \brief Looking for the anchor.
+        Searching,
+
+        /// \brief Following the path, the element at <code>Depth</code> is on it.
+        Navigating,
+
+        /// \brief Inside the region, the region is the element at <code>Depth</code>.
+        Collecting,
+
+        Found,
+
+        /// \brief The path leads out of the tree.
+        Missing
+    };
+
+    enum class NodeType
+    {
+        Element,
+        Text,
+        Comment
+    };
+
+    class Region
+    {
+    public:
+        CharString Attribute;
+        int Occurrence;
+        std::vector<int> Path;
+        std::vector<CharString> IgnoringTags;
+        bool DecodesEntities;
+
+        RegionState State = RegionState::Searching;
+
+        /// \brief The number of elements with the attribute met so far.
+        int Matched = 0;
+
+        /// \brief Depth of the element being navigated or collected.
+        int Depth = 0;
+
+        /// \brief The number of indexes of the path followed so far.
+        int Step = 0;
+
+        /// \brief Depth of the ignored element the scan is in, 0 if not in one.
+        int IgnoredDepth = 0;
+
+        /// \brief The texts collected so far, they point into the scanned file.
+        std::vector<CharStringView> Pieces;
+
+        CharString Content;
+    };
+
+    std::vector<Region> _regions;
+
+    /// \brief The number of children of each open element, the pseudo root at depth 0 is at the front.
+    std::vector<int> _childCounts = std::vector<int>(1, 0);
+
+    /// \brief Count a new node under the innermost open element and move the regions whose path goes through it.
+    void VisitChild(NodeType type, const CharStringView& nameOrContent);
+
+    /// \brief Start collecting a region at an element.
+    static void BeginCollecting(Region& region, int depth, const CharStringView& name);
+
+    /// \brief Join the collected texts of a region.
+    static void FinishCollecting(Region& region);
+
+    static bool IsIgnored(const Region& region, const CharStringView& name);
+};
+
+
+inline int HtmlRegionMatcher::AddRegion(const CharString& attribute, const int occurrence,
+                                        const std::vector<int>& path, const std::vector<CharString>& ignoringTags,
+                                        const bool decodesEntities)
+{
+    Region region;
+    region.Attribute = attribute;
+    region.Occurrence = occurrence;
+    region.Path = path;
+    region.IgnoringTags = ignoringTags;
+    region.DecodesEntities = decodesEntities;
+
+    _regions.push_back(region);
+    return static_cast<int>(_regions.size()) - 1;
+}
+
+
+inline bool HtmlRegionMatcher::IsFound(const int region) const
+{
+    return _regions[region].State == RegionState::Found;
+}
+
+
+inline const CharString& HtmlRegionMatcher::GetContent(const int region) const
+{
+    if (!IsFound(region))
+    {
+        throw std::logic_error("Region not found in HtmlRegionMatcher::GetContent()");
+    }
+
+    return _regions[region].Content;
+}
+
+
+inline CharString HtmlRegionMatcher::TakeContent(const int region)
+{
+    if (!IsFound(region))
+    {
+        throw std::logic_error("Region not found in HtmlRegionMatcher::TakeContent()");
+    }
+
+    return std::move(_regions[region].Content);
+}
+
+
+inline void HtmlRegionMatcher::OnStartElement(const CharStringView& name,
+                                              const std::vector<CharStringView>& attributes)
+{
+    VisitChild(NodeType::Element, name);
+
+    const auto depth = static_cast<int>(_childCounts.size());
+    for (auto& region : _regions)
+    {
+        if (region.State == RegionState::Collecting && region.Depth < depth &&
+            region.IgnoredDepth == 0 && IsIgnored(region, name))
+        {
+            region.IgnoredDepth = depth;
+        }
+
+        if (region.State != RegionState::Searching)
+        {
+            continue;
+        }
+
+        for (const auto& attribute : attributes)
+        {
+            if (attribute == region.Attribute)
+            {
+                if (region.Matched == region.Occurrence)
+                {
+                    if (region.Path.empty())
+                    {
+                        BeginCollecting(region, depth, name);
+                    }
+                    else
+                    {
+                        region.State = RegionState::Navigating;
+                        region.Depth = depth;
+                    }
+                }
+
+                region.Matched++;
+                break;
+            }
+        }
+    }
+
+    _childCounts.push_back(0);
+}
+
+
+inline void HtmlRegionMatcher::OnEndElement(const CharStringView&)
+{
+    const auto depth = static_cast<int>(_childCounts.size()) - 1;
+    for (auto& region : _regions)
+    {
+        if (region.IgnoredDepth == depth)
+        {
+            region.IgnoredDepth = 0;
+        }
+
+        if (region.Depth != depth)
+        {
+            continue;
+        }
+
+        if (region.State == RegionState::Collecting)
+        {
+            FinishCollecting(region);
+        }
+        else if (region.State == RegionState::Navigating)
+        {
+            // The element has fewer children than the path asks for.
+            region.State = RegionState::Missing;
+        }
+    }
+
+    _childCounts.pop_back();
+}
+
+
+inline void HtmlRegionMatcher::OnText(const CharStringView& text)
+{
+    VisitChild(NodeType::Text, text);
+
+    const auto depth = static_cast<int>(_childCounts.size()) - 1;
+    for (auto& region : _regions)
+    {
+        if (region.State == RegionState::Collecting && region.Depth <= depth && region.IgnoredDepth == 0)
+        {
+            region.Pieces.push_back(text);
+        }
+    }
+}
+
+
+inline void HtmlRegionMatcher::OnComment(const CharStringView& comment)
+{
+    VisitChild(NodeType::Comment, comment);
+}
+
+
+inline void HtmlRegionMatcher::VisitChild(const NodeType type, const CharStringView& nameOrContent)
+{
+    const auto parentDepth = static_cast<int>(_childCounts.size()) - 1;
+    const auto index = _childCounts.back()++;
+
+    for (auto& region : _regions)
+    {
+        if (region.State != RegionState::Navigating || region.Depth != parentDepth ||
+            region.Path[region.Step] != index)
+        {
+            continue;
+        }
+
+        region.Step++;
+        if (type != NodeType::Element)
+        {
+            // A text or a comment has no children, the path ends here or leads nowhere.
+            if (region.Step != static_cast<int>(region.Path.size()))
+            {
+                region.State = RegionState::Missing;
+            }
+            else
+            {
+                region.State = RegionState::Found;
+                if (type == NodeType::Text)
+                {
+                    region.Pieces.push_back(nameOrContent);
+                    FinishCollecting(region);
+                }
+            }
+        }
+        else if (region.Step == static_cast<int>(region.Path.size()))
+        {
+            BeginCollecting(region, parentDepth + 1, nameOrContent);
+        }
+        else
+        {
+            region.Depth = parentDepth + 1;
+        }
+    }
+}
+
+
+inline void HtmlRegionMatcher::BeginCollecting(Region& region, const int depth, const CharStringView& name)
+{
+    if (IsIgnored(region, name))
+    {
+        region.State = RegionState::Found;
+        return;
+    }
+
+    region.State = RegionState::Collecting;
+    region.Depth = depth;
+}
+
+
+inline void HtmlRegionMatcher::FinishCollecting(Region& region)
+{
+    auto length = 0;
+    for (const auto& piece : region.Pieces)
+    {
+        length += piece.GetLength();
+    }
+
+    StringBuilder content(length);
+    for (const auto& piece : region.Pieces)
+    {
+        const auto start = content.GetLength();
+        content.Append(piece);
+
+        // A reference can not span two texts, there is a tag between them.
+        if (region.DecodesEntities)
+        {
+            content.Truncate(start + HtmlEntity::Decode(content.GetData() + start, piece.GetLength()));
+        }
+    }
+
+    region.Content = content.ToCharString();
+
+    region.Pieces.clear();
+    region.Pieces.shrink_to_fit();
+    region.State = RegionState::Found;
+}
+
+
+inline bool HtmlRegionMatcher::IsIgnored(const Region& region, const CharStringView& name)
+{
+    for (const auto& tag : region.IgnoringTags)
+    {
+        if (tag == name)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+#endif //DATASTRUCTUREPROJECT_HTMLREGIONMATCHER_HPP
@@ -0,0 +1,324 @@
+//
+// Created on 2026/10/16 at 17:50.
+//
+
+#ifndef DATASTRUCTUREPROJECT_HTMLTOKENIZER_HPP
+#define DATASTRUCTUREPROJECT_HTMLTOKENIZER_HPP
+
+#include <vector>
+#include <stdexcept>
+#include "CharString.hpp"
+#include "CharStringView.hpp"
+#include "Simd.hpp"
+
+
+/// \brief Scan a xml/html file once and report its elements, texts and comments as events, without building a tree.
+/// \note The events are balanced: every start of an element is followed by its end, and elements nest properly.
+/// The same recovery rules as the xml tree are applied:
+/// inline tags end at once, a closing tag ends all the elements left open inside its element,
+/// a closing tag without an open element is dropped, and the elements still open at the end of the file are ended.
+/// Texts, comments, closing tags and quoted attribute values are skipped to their delimiters with <code>Simd</code>,
+/// a file cut off in the middle of a tag ends the tag at the end of the file.
+class HtmlTokenizer
+{
+public:
+    /// \brief Tokenize a xml/html file.
+    /// \tparam THandler Type of the handler, it needs these members:
+    /// <code>OnStartElement(const CharStringView& name, const std::vector<CharStringView>& attributes)</code>,
+    /// <code>OnEndElement(const CharStringView& name)</code>,
+    /// <code>OnText(const CharStringView& text)</code> and <code>OnComment(const CharStringView& comment)</code>.
+    /// \param html Content of the xml/html, the views passed to the handler point into it.
+    /// \param handler The handler receiving the events.
+    template <typename THandler>
+    static void Tokenize(const CharString& html, THandler& handler);
+
+    /// \brief Test if a tag is an inline tag.
+    /// \param tag The name of the tag to be tested.
+    /// \return True if the tag is an inline tag, otherwise false.
+    /// \note The tag is compared with at most one inline tag, the one in its slot of a perfect hash table.
+    static bool IsInlineTag(const CharStringView& tag);
+
+private:
+    /// \brief The inline tags by their slots, built at compile time.
+    class InlineTagTable
+    {
+    public:
+        static const int SlotCount = 32;
+
+        const wchar_t* Tags[SlotCount];
+        int Lengths[SlotCount];
+
+        /// \brief Put each inline tag in its slot.
+        /// \note Two tags in the same slot make the table not a constant, so it fails to compile.
+        constexpr InlineTagTable();
+
+        /// \brief Get the slot of a tag from its length and its first and last characters.
+        static constexpr int GetSlot(wchar_t first, wchar_t last, int length);
+    };
+};
+
+
+template <typename THandler>
+void HtmlTokenizer::Tokenize(const CharString& html, THandler& handler)
+{
+    // Names of the open elements, the innermost one is at the back.
+    std::vector<CharStringView> openElements;
+    std::vector<CharStringView> attributes;
+
+    const CharStringView page = html;
+    const auto data = page.GetData();
+    const auto length = page.GetLength();
+    auto reading = 0;
+
+    // Texts, comments and attribute values are skipped to their delimiters a block at a time.
+    const auto find = [data, length](const int from, const wchar_t delimiter)
+    {
+        return from + Simd::FindChar(data + from, length - from, delimiter);
+    };
+
+    while (reading < length)
+    {
+        // It is a tag.
+        if (data[reading] == L'<')
+        {
+            reading++;
+            while (reading < length && CharString::IsSpace(data[reading]))
+            {
+                reading++;
+            }
+
+            // Now the data[reading] is pointing to the name of the tag.
+            if (reading == length)
+            {
+                break;
+            }
+
+            if (data[reading] == L'!' || data[reading] == L'?') // Test if the tag is an comment.
+            {
+                auto start = reading;
+
+                // Check if is a real comment.
+                // Because there are HTMLs like this:
+                //
+                // <!--[if lt IE 9]>
+                // <script src = "https://static.zhihu.com/static/components/respond/dest/respond.min.js">< / script>
+                // <![endif]-->
+                //
+                // They are all comments.
+                const auto isRealComment = length > reading + 2 &&
+                    data[reading + 1] == L'-' && data[reading + 2] == L'-';
+
+                reading = find(reading + 1, L'>');
+                if (isRealComment)
+                {
+                    // A real comment ends at the first "-->", the '>' before it are in the comment.
+                    while (reading < length && !(data[reading - 1] == L'-' && data[reading - 2] == L'-'))
+                    {
+                        reading = find(reading + 1, L'>');
+                    }
+                }
+
+                handler.OnComment(CharStringView(data + start, reading - start));
+                reading++;
+            }
+            else if (data[reading] == L'/') // Test if the tag is closing.
+            {
+                reading++;
+                while (reading < length && CharString::IsSpace(data[reading]))
+                {
+                    reading++;
+                }
+
+                auto nameStart = reading;
+
+                while (reading < length && data[reading] != L'>' && data[reading] != L' ')
+                {
+                    reading++;
+                }
+
+                const auto closingTagName = CharStringView(data + nameStart, reading - nameStart);
+
+                reading = find(reading, L'>') + 1;
+
+                // Some of the tags are not closed!
+                auto matching = static_cast<int>(openElements.size()) - 1;
+                while (matching >= 0 && openElements[matching] != closingTagName)
+                {
+                    matching--;
+                }
+
+                if (matching >= 0)
+                {
+                    while (static_cast<int>(openElements.size()) > matching)
+                    {
+                        handler.OnEndElement(openElements.back());
+                        openElements.pop_back();
+                    }
+                }
+            }
+            else // It should be an opening tag.
+            {
+                auto start = reading;
+
+                // goto the first space or '>'
+                while (reading < length && !CharString::IsSpace(data[reading]) && data[reading] != L'>')
+                {
+                    reading++;
+                }
+
+                const auto name = CharStringView(data + start, reading - start);
+                attributes.clear();
+
+                // Read all attributes.
+                while (reading < length && data[reading] != L'>')
+                {
+                    // goto the first letter or '>'
+                    while (reading < length && CharString::IsSpace(data[reading]))
+                    {
+                        reading++;
+                    }
+
+                    if (reading == length)
+                    {
+                        break;
+                    }
+                    if (data[reading] == L'/') // The tag closes it self.
+                    {
+                        reading++;
+                        continue;
+                    }
+                    if (data[reading] == L'>')
+                    {
+                        break;
+                    }
+                    // This is an attribute, read it.
+                    auto attributeStart = reading;
+
+                    while (true)
+                    {
+                        reading++;
+                        // The attribute may be in format of xxx or xxx="yyy".
+                        // e.g. <input type="text" name="account" aria-label="xxxxx" placeholder="xxxxx" required>
+
+                        // For format xxx.
+                        if (reading == length || data[reading] == L'>')
+                        {
+                            break;
+                        }
+                        // For format xxx="yyy" or xxx='yyy'.
+                        else if (data[reading] == L'=')
+                        {
+                            reading++;
+                            while (reading < length && CharString::IsSpace(data[reading]))
+                            {
+                                reading++;
+                            }
+
+                            if (reading == length)
+                            {
+                                break;
+                            }
+
+                            // Get the type of the quotation mark.
+                            const auto quotationMark = data[reading];
+                            reading = find(reading + 1, quotationMark);
+                            if (reading < length)
+                            {
+                                reading++;
+                            }
+                            break;
+                        }
+                    }
+
+                    attributes.push_back(CharStringView(data + attributeStart, reading - attributeStart));
+                }
+
+                handler.OnStartElement(name, attributes);
+
+                // The element may be an inline element.
+                if (IsInlineTag(name))
+                {
+                    handler.OnEndElement(name);
+                }
+                else
+                {
+                    openElements.push_back(name);
+                }
+
+                reading++;
+            }
+        }
+        else if (CharString::IsSpace(data[reading]))
+        {
+            reading++;
+        }
+        else // It is a text.
+        {
+            auto start = reading;
+            reading = find(reading, L'<');
+
+            handler.OnText(CharStringView(data + start, reading - start));
+        }
+    }
+
+    // Some of the tags are not closed!
+    while (!openElements.empty())
+    {
+        handler.OnEndElement(openElements.back());
+        openElements.pop_back();
+    }
+}
+
+
+constexpr int HtmlTokenizer::InlineTagTable::GetSlot(const wchar_t first, const wchar_t last, const int length)
+{
+    // The multipliers are chosen so that the 16 inline tags fall in distinct slots.
+    return static_cast<int>((static_cast<unsigned int>(first) * 6 + static_cast<unsigned int>(last) +
+        static_cast<unsigned int>(length) * 3) % SlotCount);
+}
+
+
+constexpr HtmlTokenizer::InlineTagTable::InlineTagTable()
+    : Tags(), Lengths()
+{
+    const wchar_t* tags[] = {
+        L"area", L"base", L"br", L"col", L"command", L"embed", L"hr", L"img",
+        L"input", L"keygen", L"link", L"meta", L"param", L"source", L"track", L"wbr"
+    };
+
+    for (const auto tag : tags)
+    {
+        auto length = 0;
+        while (tag[length] != L'\0')
+        {
+            length++;
+        }
+
+        const auto slot = GetSlot(tag[0], tag[length - 1], length);
+        if (Tags[slot] != nullptr)
+        {
+            throw std::logic_error("Inline tags collide in HtmlTokenizer::InlineTagTable");
+        }
+
+        Tags[slot] = tag;
+        Lengths[slot] = length;
+    }
+}
+
+
+inline bool HtmlTokenizer::IsInlineTag(const CharStringView& tag)
+{
+    static constexpr InlineTagTable table;
+
+    const auto length = tag.GetLength();
+    if (length == 0)
+    {
+        return false;
+    }
+
+    const auto slot = InlineTagTable::GetSlot(tag[0], tag[length - 1], length);
+    return table.Lengths[slot] == length && tag == CharStringView(table.Tags[slot], length);
+}
+
+
+#endif //DATASTRUCTUREPROJECT_HTMLTOKENIZER_HPP
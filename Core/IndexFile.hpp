@@ -0,0 +1,620 @@
+//
+// Created on 2026/10/16 at 14:10.
+//
+
+#ifndef DATASTRUCTUREPROJECT_INDEXFILE_HPP
+#define DATASTRUCTUREPROJECT_INDEXFILE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include "CharString.hpp"
+#include "CharStringList.hpp"
+#include "Document.hpp"
+#include "InvertedIndexNode.hpp"
+#include "MappedFile.hpp"
+#include "SortedList.hpp"
+#include "TopKQueryEngine.hpp"
+#include "Utf8.hpp"
+
+
+/// \brief The versioned binary format of a persisted inverted index.
+/// \note Layout of the file, all integers are little-endian and all the tables are 8-byte aligned:
+/// <ol>
+/// <li>A <code>Header</code>.</li>
+/// <li>The term table, one <code>TermEntry</code> per word, sorted by the UTF-8 bytes of the words.</li>
+/// <li>The document table, one <code>DocumentEntry</code> per document, sorted by id.</li>
+/// <li>The length table, the length of each document indexed by id, 0 for missing ids.</li>
+/// <li>The data area: UTF-8 words, encoded posting blocks, UTF-8 titles and contents.</li>
+/// </ol>
+/// All the offsets are counted from the beginning of the file.
+class IndexFile
+{
+public:
+    static const std::uint32_t Version = 1;
+
+    class Header
+    {
+    public:
+        char Magic[8];
+        std::uint32_t Version;
+        std::uint32_t TermCount;
+        std::uint32_t DocumentCount;
+        std::uint32_t LengthCount;
+        std::uint32_t MinimumLength;
+        std::uint32_t Reserved;
+        std::uint64_t TotalLength;
+        std::uint64_t TermTableOffset;
+        std::uint64_t DocumentTableOffset;
+        std::uint64_t LengthTableOffset;
+        std::uint64_t FileSize;
+    };
+
+    class TermEntry
+    {
+    public:
+        std::uint64_t WordOffset;
+        std::uint64_t DocumentDeltasOffset;
+        std::uint64_t FrequenciesOffset;
+        std::uint32_t WordLength;
+        std::uint32_t DocumentDeltasLength;
+        std::uint32_t FrequenciesLength;
+        std::uint32_t DocumentFrequency;
+        std::uint32_t WordLevelOccurrence;
+        std::uint32_t MaxFrequency;
+    };
+
+    class DocumentEntry
+    {
+    public:
+        std::uint64_t TitleOffset;
+        std::uint64_t ContentOffset;
+        std::uint32_t TitleLength;
+        std::uint32_t ContentLength;
+        std::int32_t Id;
+        std::int32_t Length;
+    };
+
+    /// \brief Write an inverted index and its documents to a file.
+    /// \tparam TInvertedIndex Type of the inverted index, <code>AvlTreeInvertedIndex</code>
+    /// or <code>HashMapInvertedIndex</code>.
+    /// \param filePath Path to the file, it will be overwritten.
+    /// \param invertedIndex The index to write.
+    /// \param documents All the indexed documents.
+    /// \throw std::runtime_error if the file can not be written.
+    template <typename TInvertedIndex>
+    static void Save(const std::string& filePath, TInvertedIndex& invertedIndex,
+                     const std::vector<const Document*>& documents);
+
+    /// \brief Compare two UTF-8 words in the order of the term table.
+    static int CompareWords(const char* lhs, std::uint32_t lhsLength, const char* rhs, std::uint32_t rhsLength);
+
+    static const char* GetMagic()
+    {
+        return "DSPINDEX";
+    }
+
+private:
+    /// \brief Round an offset up to a multiple of 8.
+    static std::uint64_t Align(std::uint64_t offset)
+    {
+        return (offset + 7) & ~static_cast<std::uint64_t>(7);
+    }
+};
+
+
+/// \brief An inverted index answering queries directly from a memory-mapped index file.
+/// \note Nothing is deserialized on loading, so the index is ready as soon as the file is mapped.
+class MappedInvertedIndex
+{
+public:
+    /// \brief Map an index file written by <code>IndexFile::Save</code>.
+    /// \param filePath Path to the index file.
+    /// \throw std::runtime_error if the file can not be mapped or is not a valid index file of this version.
+    explicit MappedInvertedIndex(const std::string& filePath);
+
+    /// \brief The same as <code>AvlTreeInvertedIndex::Query</code>.
+    /// \throw std::runtime_error if the postings of a word are corrupted.
+    LinkedList<std::pair<int, int>> Query(const CharStringList& queryList) const;
+
+    /// \brief The same as <code>AvlTreeInvertedIndex::QueryTopK</code>.
+    /// \throw std::runtime_error if the postings of a word are corrupted.
+    LinkedList<std::pair<int, double>> QueryTopK(const CharStringList& queryList, int k) const;
+
+    /// \brief Test if a document is in the index.
+    bool ContainsDocument(int documentId) const;
+
+    /// \brief Get the title of a document.
+    /// \throw std::out_of_range if the document is not in the index.
+    CharString GetPostTitle(int documentId) const;
+
+    /// \brief Get the content of a document.
+    /// \throw std::out_of_range if the document is not in the index.
+    CharString GetPostContent(int documentId) const;
+
+    /// \brief Get the length of a document, used by <code>TopKQueryEngine</code>.
+    int GetLength(int documentId) const;
+
+    int GetDocumentCount() const;
+    double GetAverageLength() const;
+    int GetMinimumLength() const;
+
+private:
+    class SortByRichness
+    {
+    public:
+        bool operator()(const std::pair<int, int>& lhs, const std::pair<int, int>& rhs) const
+        {
+            return lhs.second > rhs.second;
+        }
+    };
+
+    MappedFile _file;
+    const IndexFile::Header* _header = nullptr;
+    const IndexFile::TermEntry* _terms = nullptr;
+    const IndexFile::DocumentEntry* _documents = nullptr;
+    const std::int32_t* _lengths = nullptr;
+
+    /// \brief Find the entry of a word.
+    /// \return Pointer to the entry, nullptr if the word is not indexed.
+    const IndexFile::TermEntry* FindTerm(const CharString& word) const;
+
+    /// \brief Find the entry of a document.
+    /// \return Pointer to the entry, nullptr if the document is not in the index.
+    const IndexFile::DocumentEntry* FindDocument(int documentId) const;
+
+    /// \brief Get an iterator over the postings of a term.
+    PostingList::Iterator GetPostings(const IndexFile::TermEntry* term) const;
+
+    /// \brief Decode a UTF-8 string in the data area.
+    CharString GetString(std::uint64_t offset, std::uint32_t length) const;
+
+    /// \brief Test if a range of bytes is inside the file, without overflowing.
+    static bool IsInFile(std::uint64_t offset, std::uint64_t length, std::uint64_t size);
+};
+
+
+template <typename TInvertedIndex>
+void IndexFile::Save(const std::string& filePath, TInvertedIndex& invertedIndex,
+                     const std::vector<const Document*>& documents)
+{
+    // Collect and sort the words.
+    std::vector<std::pair<std::string, const InvertedIndexNode*>> words;
+    invertedIndex.Iterate([&words](const Utf8String& word, const InvertedIndexNode& node)-> void
+    {
+        words.push_back(std::make_pair(std::string(word.GetData(), word.GetByteLength()), &node));
+    });
+
+    std::sort(words.begin(), words.end(),
+              [](const std::pair<std::string, const InvertedIndexNode*>& lhs,
+                 const std::pair<std::string, const InvertedIndexNode*>& rhs)-> bool
+              {
+                  return CompareWords(lhs.first.data(), static_cast<std::uint32_t>(lhs.first.size()),
+                                      rhs.first.data(), static_cast<std::uint32_t>(rhs.first.size())) < 0;
+              }
+    );
+
+    auto sortedDocuments = documents;
+    std::sort(sortedDocuments.begin(), sortedDocuments.end(), [](const Document* lhs, const Document* rhs)-> bool
+    {
+        return lhs->Id < rhs->Id;
+    });
+
+    const auto& statistics = invertedIndex.Documents;
+    auto lengthCount = 0;
+    if (!sortedDocuments.empty())
+    {
+        lengthCount = sortedDocuments.back()->Id + 1;
+    }
+
+    Header header;
+    std::memcpy(header.Magic, GetMagic(), sizeof(header.Magic));
+    header.Version = Version;
+    header.TermCount = static_cast<std::uint32_t>(words.size());
+    header.DocumentCount = static_cast<std::uint32_t>(sortedDocuments.size());
+    header.LengthCount = static_cast<std::uint32_t>(lengthCount);
+    header.MinimumLength = static_cast<std::uint32_t>(statistics.GetMinimumLength());
+    header.Reserved = 0;
+    header.TotalLength = 0;
+    header.TermTableOffset = Align(sizeof(Header));
+    header.DocumentTableOffset = Align(header.TermTableOffset + sizeof(TermEntry) * words.size());
+    header.LengthTableOffset = Align(header.DocumentTableOffset + sizeof(DocumentEntry) * sortedDocuments.size());
+
+    const auto dataOffset = Align(header.LengthTableOffset + sizeof(std::int32_t) * lengthCount);
+    auto offset = dataOffset;
+
+    // Lay out the data area.
+    std::vector<TermEntry> termEntries(words.size());
+    for (size_t i = 0; i < words.size(); i++)
+    {
+        const auto& postings = words[i].second->DocumentOccurrenceList;
+        auto& entry = termEntries[i];
+
+        entry.WordOffset = offset;
+        entry.WordLength = static_cast<std::uint32_t>(words[i].first.size());
+        offset += entry.WordLength;
+
+        entry.DocumentDeltasOffset = offset;
+        entry.DocumentDeltasLength = static_cast<std::uint32_t>(postings.GetDocumentDeltas().size());
+        offset += entry.DocumentDeltasLength;
+
+        entry.FrequenciesOffset = offset;
+        entry.FrequenciesLength = static_cast<std::uint32_t>(postings.GetFrequencies().size());
+        offset += entry.FrequenciesLength;
+
+        entry.DocumentFrequency = static_cast<std::uint32_t>(postings.GetLength());
+        entry.WordLevelOccurrence = static_cast<std::uint32_t>(words[i].second->WordLevelOccurrence);
+        entry.MaxFrequency = static_cast<std::uint32_t>(postings.GetMaxFrequency());
+    }
+
+    std::vector<DocumentEntry> documentEntries(sortedDocuments.size());
+    std::vector<std::int32_t> lengths(lengthCount, 0);
+    std::vector<std::string> texts;
+    texts.reserve(sortedDocuments.size() * 2);
+
+    for (size_t i = 0; i < sortedDocuments.size(); i++)
+    {
+        const auto document = sortedDocuments[i];
+        auto& entry = documentEntries[i];
+
+        texts.push_back(std::string(document->PostTitle.GetData(), document->PostTitle.GetByteLength()));
+        entry.TitleOffset = offset;
+        entry.TitleLength = static_cast<std::uint32_t>(texts.back().size());
+        offset += entry.TitleLength;
+
+        texts.push_back(std::string(document->PostContent.GetData(), document->PostContent.GetByteLength()));
+        entry.ContentOffset = offset;
+        entry.ContentLength = static_cast<std::uint32_t>(texts.back().size());
+        offset += entry.ContentLength;
+
+        entry.Id = document->Id;
+        entry.Length = statistics.GetLength(document->Id);
+
+        lengths[document->Id] = entry.Length;
+        header.TotalLength += entry.Length;
+    }
+
+    header.FileSize = offset;
+
+    // Write everything in order.
+    std::ofstream fout(filePath, std::ios::binary | std::ios::trunc);
+    if (!fout)
+    {
+        throw std::runtime_error("Can not open file in IndexFile::Save()");
+    }
+
+    const char padding[8] = {};
+    auto writeAligned = [&fout, &padding](const void* data, size_t size, std::uint64_t nextOffset)-> void
+    {
+        fout.write(static_cast<const char*>(data), size);
+        const auto position = static_cast<std::uint64_t>(fout.tellp());
+        fout.write(padding, nextOffset - position);
+    };
+
+    writeAligned(&header, sizeof(Header), header.TermTableOffset);
+    writeAligned(termEntries.data(), sizeof(TermEntry) * termEntries.size(), header.DocumentTableOffset);
+    writeAligned(documentEntries.data(), sizeof(DocumentEntry) * documentEntries.size(), header.LengthTableOffset);
+    writeAligned(lengths.data(), sizeof(std::int32_t) * lengths.size(), dataOffset);
+
+    for (const auto& word : words)
+    {
+        const auto& postings = word.second->DocumentOccurrenceList;
+        fout.write(word.first.data(), word.first.size());
+        fout.write(reinterpret_cast<const char*>(postings.GetDocumentDeltas().data()),
+                   postings.GetDocumentDeltas().size());
+        fout.write(reinterpret_cast<const char*>(postings.GetFrequencies().data()), postings.GetFrequencies().size());
+    }
+
+    for (const auto& text : texts)
+    {
+        fout.write(text.data(), text.size());
+    }
+
+    if (!fout)
+    {
+        throw std::runtime_error("Can not write file in IndexFile::Save()");
+    }
+}
+
+
+inline int IndexFile::CompareWords(const char* lhs, const std::uint32_t lhsLength, const char* rhs,
+                                   const std::uint32_t rhsLength)
+{
+    const auto result = std::memcmp(lhs, rhs, std::min(lhsLength, rhsLength));
+    if (result != 0)
+    {
+        return result;
+    }
+
+    if (lhsLength == rhsLength)
+    {
+        return 0;
+    }
+
+    return lhsLength < rhsLength ? -1 : 1;
+}
+
+
+inline MappedInvertedIndex::MappedInvertedIndex(const std::string& filePath)
+    : _file(filePath)
+{
+    const auto data = _file.GetData();
+    const auto size = static_cast<std::uint64_t>(_file.GetSize());
+
+    if (size < sizeof(IndexFile::Header))
+    {
+        throw std::runtime_error("File too small in MappedInvertedIndex::MappedInvertedIndex()");
+    }
+
+    _header = reinterpret_cast<const IndexFile::Header*>(data);
+
+    if (std::memcmp(_header->Magic, IndexFile::GetMagic(), sizeof(_header->Magic)) != 0 ||
+        _header->Version != IndexFile::Version || _header->FileSize != size)
+    {
+        throw std::runtime_error("Not a valid index file in MappedInvertedIndex::MappedInvertedIndex()");
+    }
+
+    const auto termTableSize = std::uint64_t{sizeof(IndexFile::TermEntry)} * _header->TermCount;
+    const auto documentTableSize = std::uint64_t{sizeof(IndexFile::DocumentEntry)} * _header->DocumentCount;
+    const auto lengthTableSize = std::uint64_t{sizeof(std::int32_t)} * _header->LengthCount;
+    if (!IsInFile(_header->TermTableOffset, termTableSize, size) ||
+        !IsInFile(_header->DocumentTableOffset, documentTableSize, size) ||
+        !IsInFile(_header->LengthTableOffset, lengthTableSize, size))
+    {
+        throw std::runtime_error("Corrupted index file in MappedInvertedIndex::MappedInvertedIndex()");
+    }
+
+    _terms = reinterpret_cast<const IndexFile::TermEntry*>(data + _header->TermTableOffset);
+    _documents = reinterpret_cast<const IndexFile::DocumentEntry*>(data + _header->DocumentTableOffset);
+    _lengths = reinterpret_cast<const std::int32_t*>(data + _header->LengthTableOffset);
+
+    // The entries are read without checks afterwards, so every range they point to is checked once here.
+    // Each posting takes at least a byte in both blocks, which also bounds the number of postings.
+    for (auto i = 0u; i < _header->TermCount; i++)
+    {
+        const auto& term = _terms[i];
+        if (!IsInFile(term.WordOffset, term.WordLength, size) ||
+            !IsInFile(term.DocumentDeltasOffset, term.DocumentDeltasLength, size) ||
+            !IsInFile(term.FrequenciesOffset, term.FrequenciesLength, size) ||
+            term.DocumentFrequency > term.DocumentDeltasLength || term.DocumentFrequency > term.FrequenciesLength)
+        {
+            throw std::runtime_error("Corrupted term entry in MappedInvertedIndex::MappedInvertedIndex()");
+        }
+    }
+
+    for (auto i = 0u; i < _header->DocumentCount; i++)
+    {
+        const auto& document = _documents[i];
+        if (!IsInFile(document.TitleOffset, document.TitleLength, size) ||
+            !IsInFile(document.ContentOffset, document.ContentLength, size))
+        {
+            throw std::runtime_error("Corrupted document entry in MappedInvertedIndex::MappedInvertedIndex()");
+        }
+    }
+}
+
+
+inline LinkedList<std::pair<int, int>> MappedInvertedIndex::Query(const CharStringList& queryList) const
+{
+    // (document id, occurrence) of every matching posting, repeated words in the query count repeatedly.
+    std::vector<std::pair<int, int>> hits;
+
+    for (const auto& item : queryList)
+    {
+        const auto term = FindTerm(item);
+        if (term == nullptr)
+        {
+            continue;
+        }
+
+        const PostingList::Iterator end(nullptr, 0, nullptr, 0, 0);
+        for (auto i = GetPostings(term); i != end; ++i)
+        {
+            hits.push_back(std::make_pair(i->DocumentId, i->Frequency));
+        }
+    }
+
+    std::sort(hits.begin(), hits.end());
+
+    // Documents in ascending order of id with their occurrence, and their richness in another list.
+    std::vector<std::pair<int, int>> occurrences;
+    SortedList<std::pair<int, int>, SortByRichness, ArenaNodeAllocator> sortedResult;
+    auto richness = 0;
+
+    for (size_t i = 0; i < hits.size(); i++)
+    {
+        if (!occurrences.empty() && occurrences.back().first == hits[i].first)
+        {
+            occurrences.back().second += hits[i].second;
+        }
+        else
+        {
+            occurrences.push_back(hits[i]);
+        }
+
+        richness++;
+        if (i + 1 == hits.size() || hits[i + 1].first != hits[i].first)
+        {
+            // Inserted in the same order as AvlTreeInvertedIndex::Query, so ties are ordered the same.
+            sortedResult.Insert(std::make_pair(hits[i].first, richness));
+            richness = 0;
+        }
+    }
+
+    LinkedList<std::pair<int, int>> ret;
+    for (const auto& item : sortedResult)
+    {
+        const auto location = std::lower_bound(occurrences.begin(), occurrences.end(),
+                                               std::make_pair(item.first, 0));
+        ret.Append(*location);
+    }
+
+    return ret;
+}
+
+
+inline LinkedList<std::pair<int, double>> MappedInvertedIndex::QueryTopK(const CharStringList& queryList,
+                                                                        const int k) const
+{
+    std::vector<TermCursor> cursors;
+    std::vector<const IndexFile::TermEntry*> visited;
+
+    for (const auto& item : queryList)
+    {
+        const auto term = FindTerm(item);
+
+        // Repeated words in the query are scored once.
+        if (term != nullptr && std::find(visited.begin(), visited.end(), term) == visited.end())
+        {
+            visited.push_back(term);
+            cursors.push_back(TermCursor(GetPostings(term), PostingList::Iterator(nullptr, 0, nullptr, 0, 0),
+                                         static_cast<int>(term->DocumentFrequency),
+                                         static_cast<int>(term->MaxFrequency)));
+        }
+    }
+
+    return TopKQueryEngine::Query(cursors, *this, k);
+}
+
+
+inline bool MappedInvertedIndex::ContainsDocument(const int documentId) const
+{
+    return FindDocument(documentId) != nullptr;
+}
+
+
+inline CharString MappedInvertedIndex::GetPostTitle(const int documentId) const
+{
+    const auto document = FindDocument(documentId);
+    if (document == nullptr)
+    {
+        throw std::out_of_range("No such document in MappedInvertedIndex::GetPostTitle()");
+    }
+
+    return GetString(document->TitleOffset, document->TitleLength);
+}
+
+
+inline CharString MappedInvertedIndex::GetPostContent(const int documentId) const
+{
+    const auto document = FindDocument(documentId);
+    if (document == nullptr)
+    {
+        throw std::out_of_range("No such document in MappedInvertedIndex::GetPostContent()");
+    }
+
+    return GetString(document->ContentOffset, document->ContentLength);
+}
+
+
+inline int MappedInvertedIndex::GetLength(const int documentId) const
+{
+    if (documentId < 0 || documentId >= static_cast<int>(_header->LengthCount))
+    {
+        return 0;
+    }
+
+    return _lengths[documentId];
+}
+
+
+inline int MappedInvertedIndex::GetDocumentCount() const
+{
+    return static_cast<int>(_header->DocumentCount);
+}
+
+
+inline double MappedInvertedIndex::GetAverageLength() const
+{
+    if (_header->DocumentCount == 0)
+    {
+        return 0;
+    }
+
+    return static_cast<double>(_header->TotalLength) / _header->DocumentCount;
+}
+
+
+inline int MappedInvertedIndex::GetMinimumLength() const
+{
+    return static_cast<int>(_header->MinimumLength);
+}
+
+
+inline const IndexFile::TermEntry* MappedInvertedIndex::FindTerm(const CharString& word) const
+{
+    const auto wstring = word.ToStdWstring();
+    const auto encoded = Utf8::Encode(wstring);
+    const auto encodedLength = static_cast<std::uint32_t>(encoded.size());
+    const auto data = reinterpret_cast<const char*>(_file.GetData());
+
+    const auto end = _terms + _header->TermCount;
+    const auto location = std::lower_bound(_terms, end, encoded,
+                                           [data](const IndexFile::TermEntry& entry,
+                                                                 const std::string& target)-> bool
+                                           {
+                                               return IndexFile::CompareWords(
+                                                   data + entry.WordOffset, entry.WordLength,
+                                                   target.data(), static_cast<std::uint32_t>(target.size())) < 0;
+                                           }
+    );
+
+    if (location == end ||
+        IndexFile::CompareWords(data + location->WordOffset, location->WordLength, encoded.data(), encodedLength) !=
+        0)
+    {
+        return nullptr;
+    }
+
+    return location;
+}
+
+
+inline const IndexFile::DocumentEntry* MappedInvertedIndex::FindDocument(const int documentId) const
+{
+    const auto end = _documents + _header->DocumentCount;
+    const auto location = std::lower_bound(_documents, end, documentId,
+                                           [](const IndexFile::DocumentEntry& entry, const int id)-> bool
+                                           {
+                                               return entry.Id < id;
+                                           }
+    );
+
+    if (location == end || location->Id != documentId)
+    {
+        return nullptr;
+    }
+
+    return location;
+}
+
+
+inline PostingList::Iterator MappedInvertedIndex::GetPostings(const IndexFile::TermEntry* term) const
+{
+    const auto data = _file.GetData();
+    return PostingList::Iterator(data + term->DocumentDeltasOffset, static_cast<int>(term->DocumentDeltasLength),
+                                 data + term->FrequenciesOffset, static_cast<int>(term->FrequenciesLength),
+                                 static_cast<int>(term->DocumentFrequency));
+}
+
+
+inline CharString MappedInvertedIndex::GetString(const std::uint64_t offset, const std::uint32_t length) const
+{
+    const auto data = reinterpret_cast<const char*>(_file.GetData());
+    return CharString(Utf8::Decode(data + offset, static_cast<int>(length)));
+}
+
+
+inline bool MappedInvertedIndex::IsInFile(const std::uint64_t offset, const std::uint64_t length,
+                                          const std::uint64_t size)
+{
+    return length <= size && offset <= size - length;
+}
+
+
+#endif //DATASTRUCTUREPROJECT_INDEXFILE_HPP
@@ -6,12 +6,14 @@
 #define DATASTRUCTUREPROJECT_INFORMATIONEXTRACTER_HPP
 
 #include "CharString.hpp"
-#include "CharStringList.hpp"
-#include "XmlParser.hpp"
-#include "Spider.hpp"
+#include "XmlNode.hpp"
+#include "XmlNodeIndex.hpp"
+#include "ExtractionPlan.hpp"
 
 /// \brief A class to extracte information from <a href="http://bbs.cehome.com/">cehome bbs</a>.
 /// \note To use the class, you need to construct an instance with a HTML node. You can get the node with XmlParser.
+/// All the fields are extracted with <code>ExtractionPlan::GetThreadPlan()</code> when the first one is asked for,
+/// in one walk of the tree, or without a walk if the elements of the tree were indexed while parsing.
 class InformationExtracter
 {
 public:
@@ -44,9 +46,65 @@ public:
     CharString GetPostType();
 
     explicit InformationExtracter(XmlNode* root);
+
+    /// \param root The HTML node.
+    /// \param index The index filled when parsing the tree of <code>root</code>, it can be nullptr.
+    InformationExtracter(XmlNode* root, XmlNodeIndex* index);
 private:
     /// \brief Pointer to the XmlNode.
     XmlNode* _root;
+
+    /// \brief The index of the tree, nullptr if the tree is walked instead.
+    XmlNodeIndex* _index = nullptr;
+
+    /// \brief The extracted fields, valid if <code>_isExtracted</code>.
+    ExtractionPlan::Record _record;
+    bool _isExtracted = false;
+
+    /// \brief Get a field, extract all of them first if not yet.
+    /// \throw std::logic_error if the field is not in the tree.
+    const CharString& GetField(ExtractionPlan::Field field);
+};
+
+
+/// \brief Extract the same information as <code>InformationExtracter</code> from a HTML file,
+/// in one scan with <code>HtmlTokenizer</code> and without building the xml tree, see <code>ExtractionPlan</code>.
+/// \note All the information is collected by the constructor, the HTML file is not needed afterwards.
+class StreamingInformationExtracter
+{
+public:
+    /// \brief Get the BigCategory of the thread in the instance.
+    /// \return BigCategory of the thread.
+    /// \throw std::logic_error if it is not in the HTML file, the same for the other methods.
+    CharString GetBigCategory() const;
+
+    /// \brief Get the SmallCategory of the thread in the instance.
+    /// \return SmallCategory of the thread.
+    CharString GetSmallCategory() const;
+
+    /// \brief Get the PostTitle of the thread in the instance.
+    /// \return PostTitle of the thread.
+    CharString GetPostTitle() const;
+
+    /// \brief Get the PostContent of the thread in the instance.
+    /// \return PostContent of the thread.
+    CharString GetPostContent() const;
+
+    /// \brief Get the PostAuthor of the thread in the instance.
+    /// \return PostAuthor of the thread.
+    CharString GetPostAuthor() const;
+
+    /// \brief Get the PostDate of the thread in the instance.
+    /// \return PostDate of the thread.
+    CharString GetPostDate() const;
+
+    /// \brief Get the PostType of the thread in the instance.
+    /// \return PostType of the thread.
+    CharString GetPostType() const;
+
+    explicit StreamingInformationExtracter(const CharString& html);
+private:
+    ExtractionPlan::Record _record;
 };
 
 
@@ -56,114 +114,111 @@ InformationExtracter::InformationExtracter(XmlNode* root)
 }
 
 
-CharString InformationExtracter::GetBigCategory()
+InformationExtracter::InformationExtracter(XmlNode* root, XmlNodeIndex* index)
+    : _root(root), _index(index)
 {
-    CharString attribution;
-    attribution.FromStdWstring(std::wstring(L"id=\"pt\""));
-    auto divPt = XmlParser::GetElementsByAttribution(_root, attribution).GetItemAt(0);
+}
+
 
-    LinkedList<int> path;
-    path.Append(0);
-    path.Append(4);
-    auto anchor = XmlParser::NavigateFrom(divPt, path);
+const CharString& InformationExtracter::GetField(const ExtractionPlan::Field field)
+{
+    if (!_isExtracted)
+    {
+        _record = ExtractionPlan::GetThreadPlan().Execute(_root, _index);
+        _isExtracted = true;
+    }
 
-    return XmlParser::GetContent(anchor);
+    return _record.Get(field);
 }
 
 
-CharString InformationExtracter::GetSmallCategory()
+CharString InformationExtracter::GetBigCategory()
 {
-    CharString attribution;
-    attribution.FromStdWstring(std::wstring(L"id=\"pt\""));
-    auto divPt = XmlParser::GetElementsByAttribution(_root, attribution).GetItemAt(0);
+    return GetField(ExtractionPlan::Field::BigCategory);
+}
 
-    LinkedList<int> path;
-    path.Append(0);
-    path.Append(6);
-    auto anchor = XmlParser::NavigateFrom(divPt, path);
 
-    return XmlParser::GetContent(anchor);
+CharString InformationExtracter::GetSmallCategory()
+{
+    return GetField(ExtractionPlan::Field::SmallCategory);
 }
 
 
 CharString InformationExtracter::GetPostTitle()
 {
-    CharString attribution;
-    attribution.FromStdWstring(std::wstring(L"id=\"thread_subject\""));
-    auto anchor = XmlParser::GetElementsByAttribution(_root, attribution).GetItemAt(0);
-
-    LinkedList<int> path;
-    path.Append(0);
-    auto header = XmlParser::NavigateFrom(anchor, path);
-
-    return XmlParser::GetContent(header);
+    return GetField(ExtractionPlan::Field::PostTitle);
 }
 
 
 CharString InformationExtracter::GetPostContent()
 {
-    CharString ignore;
-    ignore.FromStdWstring(std::wstring(L"ignore_js_op"));
-
-    CharStringList ignoringList;
-    ignoringList.Append(ignore);
+    return GetField(ExtractionPlan::Field::PostContent);
+}
 
-    CharString attribution;
-    attribution.FromStdWstring(std::wstring(L"class=\"t_f\""));
 
-    auto td = XmlParser::GetElementsByAttribution(_root, attribution).GetItemAt(0);
+CharString InformationExtracter::GetPostAuthor()
+{
+    return GetField(ExtractionPlan::Field::PostAuthor);
+}
 
-    // Some of the contents are encoded as HTML, need to decode them.
-    auto decoded = Spider::GetDecodedHtml(XmlParser::GetContent(td, ignoringList).ToStdWstring());
-    CharString ret;
-    ret.FromStdWstring(decoded);
 
-    return ret;
+CharString InformationExtracter::GetPostDate()
+{
+    return GetField(ExtractionPlan::Field::PostDate);
 }
 
 
-CharString InformationExtracter::GetPostAuthor()
+CharString InformationExtracter::GetPostType()
 {
-    CharString attribution;
-    attribution.FromStdWstring(std::wstring(L"class=\"authi\""));
+    return GetField(ExtractionPlan::Field::PostType);
+}
 
-    auto div = XmlParser::GetElementsByAttribution(_root, attribution).GetItemAt(0);
 
-    LinkedList<int> path;
-    path.Append(0);
-    auto anchor = XmlParser::NavigateFrom(div, path);
+inline StreamingInformationExtracter::StreamingInformationExtracter(const CharString& html)
+    : _record(ExtractionPlan::GetThreadPlan().Execute(html))
+{
+}
 
-    return XmlParser::GetContent(anchor);
+
+inline CharString StreamingInformationExtracter::GetBigCategory() const
+{
+    return _record.Get(ExtractionPlan::Field::BigCategory);
 }
 
 
-CharString InformationExtracter::GetPostDate()
+inline CharString StreamingInformationExtracter::GetSmallCategory() const
 {
-    CharString attribution;
-    attribution.FromStdWstring(std::wstring(L"class=\"authi\""));
+    return _record.Get(ExtractionPlan::Field::SmallCategory);
+}
 
-    auto div = XmlParser::GetElementsByAttribution(_root, attribution).GetItemAt(1);
 
-    LinkedList<int> path;
-    path.Append(0);
-    auto em = XmlParser::NavigateFrom(div, path);
+inline CharString StreamingInformationExtracter::GetPostTitle() const
+{
+    return _record.Get(ExtractionPlan::Field::PostTitle);
+}
 
-    return XmlParser::GetContent(em);
+
+inline CharString StreamingInformationExtracter::GetPostContent() const
+{
+    return _record.Get(ExtractionPlan::Field::PostContent);
 }
 
 
-CharString InformationExtracter::GetPostType()
+inline CharString StreamingInformationExtracter::GetPostAuthor() const
 {
-    CharString attribution;
-    attribution.FromStdWstring(std::wstring(L"class=\"ts z h1\""));
+    return _record.Get(ExtractionPlan::Field::PostAuthor);
+}
 
-    auto div = XmlParser::GetElementsByAttribution(_root, attribution).GetItemAt(0);
 
-    LinkedList<int> path;
-    path.Append(0);
-    auto anchor = XmlParser::NavigateFrom(div, path);
+inline CharString StreamingInformationExtracter::GetPostDate() const
+{
+    return _record.Get(ExtractionPlan::Field::PostDate);
+}
 
-    return XmlParser::GetContent(anchor);
+
+inline CharString StreamingInformationExtracter::GetPostType() const
+{
+    return _record.Get(ExtractionPlan::Field::PostType);
 }
 
 
@@ -5,32 +5,32 @@
 #ifndef DATASTRUCTUREPROJECT_INVERTEDINDEXNODE_HPP
 #define DATASTRUCTUREPROJECT_INVERTEDINDEXNODE_HPP
 
-#include "CharString.hpp"
-#include "SortedList.hpp"
+#include "PostingList.hpp"
 #include "Document.hpp"
+#include <cstdint>
 #include <utility>
 
 class InvertedIndexNode
 {
 public:
-    class Less
-    {
-    public:
-        bool operator()(const std::pair<Document*, int>& lhs, const std::pair<Document*, int>& rhs) const
-        {
-            return lhs.second < rhs.second;
-        }
-    };
-
-    CharString Word = CharString(std::wstring());
+    /// \brief Term id of the word, the word is kept in <code>TermTable::GetGlobal()</code>.
+    std::uint32_t TermId = 0;
     int FileLevelOccurrence = 0;
     int WordLevelOccurrence = 0;
-    SortedList<std::pair<Document*, int>, Less> DocumentOccurrenceList;
 
-    void AddOccurrence(Document* document, int times);
+    /// \brief Ids of the documents containing the word and the times it occurs, in ascending order of document id.
+    PostingList DocumentOccurrenceList;
+
+    void AddOccurrence(const Document* document, int times);
+
+    /// \brief Merge the occurrences recorded by another node of the same word.
+    /// \param rhs The node to merge from.
+    /// \note The documents in <code>rhs</code> must not appear in the instance,
+    /// which holds when each document is indexed by exactly one shard.
+    void Merge(const InvertedIndexNode& rhs);
 
-    explicit InvertedIndexNode(const CharString& word)
-        : Word(word)
+    explicit InvertedIndexNode(const std::uint32_t termId)
+        : TermId(termId)
     {
     }
 
@@ -38,16 +38,18 @@ public:
     InvertedIndexNode() = default;
 
     InvertedIndexNode(const InvertedIndexNode& rhs)
-        : Word(rhs.Word),
+        : TermId(rhs.TermId),
           FileLevelOccurrence(rhs.FileLevelOccurrence),
           WordLevelOccurrence(rhs.WordLevelOccurrence),
           DocumentOccurrenceList(rhs.DocumentOccurrenceList)
     {
     }
 
+    InvertedIndexNode(InvertedIndexNode&& rhs) noexcept = default;
+
     void operator=(const InvertedIndexNode& rhs)
     {
-        Word = rhs.Word;
+        TermId = rhs.TermId;
         FileLevelOccurrence = rhs.FileLevelOccurrence;
         WordLevelOccurrence = rhs.WordLevelOccurrence;
         DocumentOccurrenceList = rhs.DocumentOccurrenceList;
@@ -55,32 +57,23 @@ public:
 };
 
 
-inline void InvertedIndexNode::AddOccurrence(Document* document, int times)
+inline void InvertedIndexNode::AddOccurrence(const Document* document, int times)
 {
-    auto location = DocumentOccurrenceList.FirstOf(
-        [document](const std::pair<Document*, int>& node)-> bool
-        {
-            return node.first == document;
-        }
-    );
-
-    if (location == DocumentOccurrenceList.end())
+    if (DocumentOccurrenceList.Add(document->Id, times))
     {
-        DocumentOccurrenceList.Insert(std::make_pair(document, times));
         FileLevelOccurrence++;
     }
-    else
-    {
-        DocumentOccurrenceList.Modify(location,
-                                      [times](std::pair<Document*, int>& node)-> void
-                                      {
-                                          node.second += times;
-                                      }
-        );
-    }
 
     WordLevelOccurrence += times;
 }
 
 
+inline void InvertedIndexNode::Merge(const InvertedIndexNode& rhs)
+{
+    DocumentOccurrenceList.Merge(rhs.DocumentOccurrenceList);
+    FileLevelOccurrence += rhs.FileLevelOccurrence;
+    WordLevelOccurrence += rhs.WordLevelOccurrence;
+}
+
+
 #endif //DATASTRUCTUREPROJECT_INVERTEDINDEXNODE_HPP
@@ -0,0 +1,46 @@
+//
+// Created on 2026/10/16 at 09:12.
+//
+
+#ifndef DATASTRUCTUREPROJECT_INVERTEDINDEXSHARDS_HPP
+#define DATASTRUCTUREPROJECT_INVERTEDINDEXSHARDS_HPP
+
+#include <vector>
+#include <omp.h>
+
+
+/// \brief A set of methods to combine inverted indexes built by separate threads.
+/// \note Each thread builds into its own shard without locking, the shards are merged afterwards.
+class InvertedIndexShards
+{
+public:
+    /// \brief Merge all the shards into the first one with a parallel tree reduction.
+    /// \tparam TInvertedIndex Type of the inverted index, need to have a method <code>Merge(TInvertedIndex&)</code>.
+    /// \param shards Pointers to the shards, each of them is built over a disjoint set of documents.
+    /// \note After the reduction, <code>shards[0]</code> holds the whole index.
+    /// The other shards are not modified, the caller still owns them.
+    template <typename TInvertedIndex>
+    static void Reduce(std::vector<TInvertedIndex*>& shards);
+};
+
+
+template <typename TInvertedIndex>
+void InvertedIndexShards::Reduce(std::vector<TInvertedIndex*>& shards)
+{
+    const auto count = static_cast<int>(shards.size());
+
+    // In each round, shard i absorbs shard (i + stride), the pairs are independent of each other.
+    for (auto stride = 1; stride < count; stride *= 2)
+    {
+        const auto step = stride * 2;
+
+#pragma omp parallel for schedule(dynamic)
+        for (auto i = 0; i < count - stride; i += step)
+        {
+            shards[i]->Merge(*shards[i + stride]);
+        }
+    }
+}
+
+
+#endif //DATASTRUCTUREPROJECT_INVERTEDINDEXSHARDS_HPP
@@ -7,11 +7,15 @@
 
 #include <stdexcept>
 #include <functional>
+#include <type_traits>
+#include <utility>
+#include "NodeAllocator.hpp"
 
 
 /// \brief A linked-list class.
 /// \tparam TElement The type of the element in the list.
-template <typename TElement>
+/// \tparam TAllocator The allocator of the nodes, <code>HeapNodeAllocator</code> or <code>ArenaNodeAllocator</code>.
+template <typename TElement, template <typename> class TAllocator = HeapNodeAllocator>
 class LinkedList
 {
 public:
@@ -97,6 +101,11 @@ private:
 
     /// \brief The cached length.
     int _length = 0;
+
+    TAllocator<LinkedListNode> _allocator;
+
+    /// \brief Destroy all the nodes.
+    void Clear();
 public:
     class ForwardIterator
     {
@@ -145,15 +154,15 @@ public:
 };
 
 
-template <typename TElement>
-LinkedList<TElement>::LinkedListNode::LinkedListNode(const TElement& element)
+template <typename TElement, template <typename> class TAllocator>
+LinkedList<TElement, TAllocator>::LinkedListNode::LinkedListNode(const TElement& element)
     : Element(element)
 {
 }
 
 
-template <typename TElement>
-void LinkedList<TElement>::InsertAt(const TElement& element, int index)
+template <typename TElement, template <typename> class TAllocator>
+void LinkedList<TElement, TAllocator>::InsertAt(const TElement& element, int index)
 {
     if (index < 0 || index > _length)
     {
@@ -162,7 +171,7 @@ void LinkedList<TElement>::InsertAt(const TElement& element, int index)
 
     if (index == 0)
     {
-        auto newHead = new LinkedListNode(element);
+        auto newHead = _allocator.Create(element);
         newHead->Next = _headNode;
         _headNode = newHead;
     }
@@ -177,7 +186,7 @@ void LinkedList<TElement>::InsertAt(const TElement& element, int index)
 
         auto next = walker->Next;
 
-        walker->Next = new LinkedListNode(element);
+        walker->Next = _allocator.Create(element);
         walker->Next->Next = next;
     }
 
@@ -185,8 +194,8 @@ void LinkedList<TElement>::InsertAt(const TElement& element, int index)
 }
 
 
-template <typename TElement>
-void LinkedList<TElement>::RemoveAt(int index)
+template <typename TElement, template <typename> class TAllocator>
+void LinkedList<TElement, TAllocator>::RemoveAt(int index)
 {
     if (index < 0 || index >= _length)
     {
@@ -197,7 +206,7 @@ void LinkedList<TElement>::RemoveAt(int index)
     {
         auto head = _headNode;
         _headNode = head->Next;
-        delete head;
+        _allocator.Destroy(head);
     }
     else
     {
@@ -210,15 +219,15 @@ void LinkedList<TElement>::RemoveAt(int index)
 
         auto next = walker->Next;
         walker->Next = next->Next;
-        delete next;
+        _allocator.Destroy(next);
     }
 
     _length--;
 }
 
 
-template <typename TElement>
-int LinkedList<TElement>::IndexOf(const TElement& element) const
+template <typename TElement, template <typename> class TAllocator>
+int LinkedList<TElement, TAllocator>::IndexOf(const TElement& element) const
 {
     auto index = 0;
     auto walker = _headNode;
@@ -244,41 +253,54 @@ int LinkedList<TElement>::IndexOf(const TElement& element) const
 }
 
 
-template <typename TElement>
-LinkedList<TElement>::~LinkedList()
+template <typename TElement, template <typename> class TAllocator>
+LinkedList<TElement, TAllocator>::~LinkedList()
+{
+    // The arena frees the nodes at once, only the elements may need to be destroyed one by one.
+    if (!TAllocator<LinkedListNode>::ReleasesAll || !std::is_trivially_destructible<TElement>::value)
+    {
+        Clear();
+    }
+}
+
+
+template <typename TElement, template <typename> class TAllocator>
+void LinkedList<TElement, TAllocator>::Clear()
 {
     while (_headNode != nullptr)
     {
         auto next = _headNode->Next;
-        delete _headNode;
+        _allocator.Destroy(_headNode);
         _headNode = next;
     }
+
+    _length = 0;
 }
 
 
-template <typename TElement>
-void LinkedList<TElement>::Append(const TElement& element)
+template <typename TElement, template <typename> class TAllocator>
+void LinkedList<TElement, TAllocator>::Append(const TElement& element)
 {
     InsertAt(element, _length);
 }
 
 
-template <typename TElement>
-const TElement& LinkedList<TElement>::GetItemAt(int index) const
+template <typename TElement, template <typename> class TAllocator>
+const TElement& LinkedList<TElement, TAllocator>::GetItemAt(int index) const
 {
     return (*this)[index];
 }
 
 
-template <typename TElement>
-int LinkedList<TElement>::GetLength() const
+template <typename TElement, template <typename> class TAllocator>
+int LinkedList<TElement, TAllocator>::GetLength() const
 {
     return _length;
 }
 
 
-template <typename TElement>
-void LinkedList<TElement>::Iterate(const std::function<void(const TElement&)>& visitFunction)
+template <typename TElement, template <typename> class TAllocator>
+void LinkedList<TElement, TAllocator>::Iterate(const std::function<void(const TElement&)>& visitFunction)
 {
     if (_headNode == nullptr)
     {
@@ -292,27 +314,39 @@ void LinkedList<TElement>::Iterate(const std::function<void(const TElement&)>& v
 }
 
 
-template <typename TElement>
-LinkedList<TElement>::LinkedList(LinkedList&& rhs) noexcept
+template <typename TElement, template <typename> class TAllocator>
+LinkedList<TElement, TAllocator>::LinkedList(LinkedList&& rhs) noexcept
+    : _allocator(std::move(rhs._allocator))
 {
     _headNode = rhs._headNode;
     _length = rhs._length;
 
     rhs._headNode = nullptr;
+    rhs._length = 0;
 }
 
-template <typename TElement>
-void LinkedList<TElement>::operator=(LinkedList&& rhs) noexcept
+template <typename TElement, template <typename> class TAllocator>
+void LinkedList<TElement, TAllocator>::operator=(LinkedList&& rhs) noexcept
 {
+    if (this == &rhs)
+    {
+        return;
+    }
+
+    // The old nodes belong to the old allocator, destroy them before taking the allocator of rhs.
+    Clear();
+    _allocator = std::move(rhs._allocator);
+
     _headNode = rhs._headNode;
     _length = rhs._length;
 
     rhs._headNode = nullptr;
+    rhs._length = 0;
 }
 
 
-template <typename TElement>
-TElement& LinkedList<TElement>::operator[](int index) const
+template <typename TElement, template <typename> class TAllocator>
+TElement& LinkedList<TElement, TAllocator>::operator[](int index) const
 {
     if (index < 0 || index >= _length)
     {
@@ -328,8 +362,8 @@ TElement& LinkedList<TElement>::operator[](int index) const
 }
 
 
-template <typename TElement>
-bool LinkedList<TElement>::Contains(const TElement& element) const
+template <typename TElement, template <typename> class TAllocator>
+bool LinkedList<TElement, TAllocator>::Contains(const TElement& element) const
 {
     auto found = false;
     auto walker = _headNode;
@@ -347,8 +381,8 @@ bool LinkedList<TElement>::Contains(const TElement& element) const
 }
 
 
-template <typename TElement>
-bool LinkedList<TElement>::ContainsIf(std::function<bool(const TElement&)>& prediction)
+template <typename TElement, template <typename> class TAllocator>
+bool LinkedList<TElement, TAllocator>::ContainsIf(std::function<bool(const TElement&)>& prediction)
 {
     auto found = false;
     auto walker = _headNode;
@@ -367,8 +401,8 @@ bool LinkedList<TElement>::ContainsIf(std::function<bool(const TElement&)>& pred
 }
 
 
-template <typename TElement>
-const TElement& LinkedList<TElement>::GetFirstOf(std::function<bool(const TElement&)>& prediction)
+template <typename TElement, template <typename> class TAllocator>
+const TElement& LinkedList<TElement, TAllocator>::GetFirstOf(std::function<bool(const TElement&)>& prediction)
 {
     auto walker = _headNode;
     while (walker != nullptr)
@@ -385,8 +419,8 @@ const TElement& LinkedList<TElement>::GetFirstOf(std::function<bool(const TEleme
 }
 
 
-template <typename TElement>
-void LinkedList<TElement>::RemoveFirstOf(std::function<bool(const TElement&)>& prediction)
+template <typename TElement, template <typename> class TAllocator>
+void LinkedList<TElement, TAllocator>::RemoveFirstOf(std::function<bool(const TElement&)>& prediction)
 {
     if (_length == 0)
     {
@@ -397,7 +431,7 @@ void LinkedList<TElement>::RemoveFirstOf(std::function<bool(const TElement&)>& p
     {
         auto temp = _headNode;
         _headNode = nullptr;
-        delete temp;
+        _allocator.Destroy(temp);
     }
     else
     {
@@ -417,7 +451,7 @@ void LinkedList<TElement>::RemoveFirstOf(std::function<bool(const TElement&)>& p
 
         slow->Next = fast->Next;
         fast->Next = nullptr;
-        delete fast;
+        _allocator.Destroy(fast);
     }
 }
 
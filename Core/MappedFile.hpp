@@ -0,0 +1,165 @@
+//
+// Created on 2026/10/16 at 13:30.
+//
+
+#ifndef DATASTRUCTUREPROJECT_MAPPEDFILE_HPP
+#define DATASTRUCTUREPROJECT_MAPPEDFILE_HPP
+
+#include <string>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+/// \brief A read-only memory mapping of a whole file.
+class MappedFile
+{
+public:
+    /// \brief Map a file into memory.
+    /// \param filePath Path to the file.
+    /// \throw std::runtime_error if the file can not be opened or mapped.
+    explicit MappedFile(const std::string& filePath);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    virtual ~MappedFile();
+
+    /// \brief Get the mapped content.
+    /// \return Pointer to the first byte of the file, nullptr if the file is empty.
+    const unsigned char* GetData() const;
+
+    /// \brief Get the size of the file.
+    /// \return The number of bytes in the file.
+    size_t GetSize() const;
+
+private:
+    const unsigned char* _data = nullptr;
+    size_t _size = 0;
+
+#ifdef _WIN32
+    HANDLE _file = INVALID_HANDLE_VALUE;
+    HANDLE _mapping = nullptr;
+#else
+    int _file = -1;
+#endif
+};
+
+
+inline MappedFile::MappedFile(const std::string& filePath)
+{
+#ifdef _WIN32
+    _file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (_file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Can not open file in MappedFile::MappedFile()");
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(_file, &size))
+    {
+        CloseHandle(_file);
+        throw std::runtime_error("Can not get file size in MappedFile::MappedFile()");
+    }
+
+    _size = static_cast<size_t>(size.QuadPart);
+    if (_size == 0)
+    {
+        return;
+    }
+
+    _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (_mapping == nullptr)
+    {
+        CloseHandle(_file);
+        throw std::runtime_error("Can not map file in MappedFile::MappedFile()");
+    }
+
+    _data = static_cast<const unsigned char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (_data == nullptr)
+    {
+        CloseHandle(_mapping);
+        CloseHandle(_file);
+        throw std::runtime_error("Can not map file in MappedFile::MappedFile()");
+    }
+#else
+    _file = open(filePath.c_str(), O_RDONLY);
+    if (_file == -1)
+    {
+        throw std::runtime_error("Can not open file in MappedFile::MappedFile()");
+    }
+
+    struct stat status;
+    if (fstat(_file, &status) != 0)
+    {
+        close(_file);
+        throw std::runtime_error("Can not get file size in MappedFile::MappedFile()");
+    }
+
+    _size = static_cast<size_t>(status.st_size);
+    if (_size == 0)
+    {
+        return;
+    }
+
+    auto mapped = mmap(nullptr, _size, PROT_READ, MAP_SHARED, _file, 0);
+    if (mapped == MAP_FAILED)
+    {
+        close(_file);
+        throw std::runtime_error("Can not map file in MappedFile::MappedFile()");
+    }
+
+    _data = static_cast<const unsigned char*>(mapped);
+#endif
+}
+
+
+inline MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+    if (_data != nullptr)
+    {
+        UnmapViewOfFile(_data);
+    }
+    if (_mapping != nullptr)
+    {
+        CloseHandle(_mapping);
+    }
+    CloseHandle(_file);
+#else
+    if (_data != nullptr)
+    {
+        munmap(const_cast<unsigned char*>(_data), _size);
+    }
+    close(_file);
+#endif
+}
+
+
+inline const unsigned char* MappedFile::GetData() const
+{
+    return _data;
+}
+
+
+inline size_t MappedFile::GetSize() const
+{
+    return _size;
+}
+
+
+#endif //DATASTRUCTUREPROJECT_MAPPEDFILE_HPP
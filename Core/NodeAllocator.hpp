@@ -0,0 +1,228 @@
+//
+// Created on 2026/10/16 at 17:20.
+//
+
+#ifndef DATASTRUCTUREPROJECT_NODEALLOCATOR_HPP
+#define DATASTRUCTUREPROJECT_NODEALLOCATOR_HPP
+
+#include <new>
+#include <utility>
+
+
+/// \brief Allocates every node of a container on its own with <code>new</code>.
+/// \tparam TNode Type of the node.
+template <typename TNode>
+class HeapNodeAllocator
+{
+public:
+    /// \brief Whether the memory of all the nodes is released together with the allocator,
+    /// so nodes holding nothing to destroy need not be visited one by one.
+    static const bool ReleasesAll = false;
+
+    /// \brief Create a node.
+    /// \param arguments The arguments passed to the constructor of the node.
+    /// \return Pointer to the node.
+    template <typename... TArguments>
+    TNode* Create(TArguments&&... arguments)
+    {
+        return new TNode(std::forward<TArguments>(arguments)...);
+    }
+
+    /// \brief Destroy a node created by the instance.
+    /// \param node Pointer to the node.
+    void Destroy(TNode* node)
+    {
+        delete node;
+    }
+};
+
+
+/// \brief Carves the nodes of a container from slabs owned by the allocator.
+/// \tparam TNode Type of the node.
+/// \note Destroyed nodes are kept in a free list and reused, creating and destroying a node are both O(1).
+/// The slabs are only freed with the allocator, which frees the memory of all the nodes at once.
+/// Each container owns its allocator, so copying an allocator gives an empty one.
+template <typename TNode>
+class ArenaNodeAllocator
+{
+public:
+    static const bool ReleasesAll = true;
+
+    /// \brief Create a node.
+    /// \param arguments The arguments passed to the constructor of the node.
+    /// \return Pointer to the node.
+    template <typename... TArguments>
+    TNode* Create(TArguments&&... arguments);
+
+    /// \brief Destroy a node created by the instance, its memory goes to the free list.
+    /// \param node Pointer to the node.
+    void Destroy(TNode* node);
+
+    ArenaNodeAllocator() = default;
+    ArenaNodeAllocator(const ArenaNodeAllocator&);
+    ArenaNodeAllocator(ArenaNodeAllocator&& rhs) noexcept;
+    ArenaNodeAllocator& operator=(const ArenaNodeAllocator&);
+    ArenaNodeAllocator& operator=(ArenaNodeAllocator&& rhs) noexcept;
+    ~ArenaNodeAllocator();
+
+private:
+    /// \brief A free node, its memory is reused to link the free list.
+    class FreeNode
+    {
+    public:
+        FreeNode* Next;
+    };
+
+    /// \brief The header of a slab, followed by the nodes.
+    class Slab
+    {
+    public:
+        Slab* Previous;
+    };
+
+    static const int MinSlabSize = 4;
+    static const int MaxSlabSize = 256;
+
+    /// \brief Size of the header rounded up, so the nodes after it are aligned.
+    static const int HeaderSize =
+        (sizeof(Slab) + alignof(TNode) - 1) / alignof(TNode) * alignof(TNode);
+
+    static_assert(sizeof(TNode) >= sizeof(FreeNode), "A node must be able to hold a free list link.");
+
+    /// \brief The last allocated slab, the earlier ones are linked through <code>Slab::Previous</code>.
+    Slab* _slab = nullptr;
+
+    /// \brief The first unused node in the last slab.
+    unsigned char* _next = nullptr;
+
+    /// \brief The number of unused nodes in the last slab.
+    int _remaining = 0;
+
+    /// \brief The number of nodes in the next slab, doubles until <code>MaxSlabSize</code>.
+    int _nextSlabSize = MinSlabSize;
+
+    FreeNode* _freeList = nullptr;
+
+    /// \brief Free all the slabs.
+    void Release();
+};
+
+
+template <typename TNode>
+template <typename... TArguments>
+TNode* ArenaNodeAllocator<TNode>::Create(TArguments&&... arguments)
+{
+    void* memory;
+
+    if (_freeList != nullptr)
+    {
+        memory = _freeList;
+        _freeList = _freeList->Next;
+    }
+    else
+    {
+        if (_remaining == 0)
+        {
+            auto slab = static_cast<Slab*>(::operator new(HeaderSize + sizeof(TNode) * _nextSlabSize));
+            slab->Previous = _slab;
+            _slab = slab;
+            _next = reinterpret_cast<unsigned char*>(slab) + HeaderSize;
+            _remaining = _nextSlabSize;
+
+            if (_nextSlabSize < MaxSlabSize)
+            {
+                _nextSlabSize *= 2;
+            }
+        }
+
+        memory = _next;
+        _next += sizeof(TNode);
+        _remaining--;
+    }
+
+    return new(memory) TNode(std::forward<TArguments>(arguments)...);
+}
+
+
+template <typename TNode>
+void ArenaNodeAllocator<TNode>::Destroy(TNode* node)
+{
+    node->~TNode();
+
+    auto freeNode = reinterpret_cast<FreeNode*>(node);
+    freeNode->Next = _freeList;
+    _freeList = freeNode;
+}
+
+
+template <typename TNode>
+ArenaNodeAllocator<TNode>::ArenaNodeAllocator(const ArenaNodeAllocator&)
+{
+}
+
+
+template <typename TNode>
+ArenaNodeAllocator<TNode>::ArenaNodeAllocator(ArenaNodeAllocator&& rhs) noexcept
+    : _slab(rhs._slab), _next(rhs._next), _remaining(rhs._remaining), _nextSlabSize(rhs._nextSlabSize),
+      _freeList(rhs._freeList)
+{
+    rhs._slab = nullptr;
+    rhs._next = nullptr;
+    rhs._remaining = 0;
+    rhs._nextSlabSize = MinSlabSize;
+    rhs._freeList = nullptr;
+}
+
+
+template <typename TNode>
+ArenaNodeAllocator<TNode>& ArenaNodeAllocator<TNode>::operator=(const ArenaNodeAllocator&)
+{
+    // The nodes of the container stay in its own slabs.
+    return *this;
+}
+
+
+template <typename TNode>
+ArenaNodeAllocator<TNode>& ArenaNodeAllocator<TNode>::operator=(ArenaNodeAllocator&& rhs) noexcept
+{
+    if (this == &rhs)
+    {
+        return *this;
+    }
+
+    Release();
+    std::swap(_slab, rhs._slab);
+    std::swap(_next, rhs._next);
+    std::swap(_remaining, rhs._remaining);
+    std::swap(_nextSlabSize, rhs._nextSlabSize);
+    std::swap(_freeList, rhs._freeList);
+
+    return *this;
+}
+
+
+template <typename TNode>
+ArenaNodeAllocator<TNode>::~ArenaNodeAllocator()
+{
+    Release();
+}
+
+
+template <typename TNode>
+void ArenaNodeAllocator<TNode>::Release()
+{
+    while (_slab != nullptr)
+    {
+        auto previous = _slab->Previous;
+        ::operator delete(_slab);
+        _slab = previous;
+    }
+
+    _next = nullptr;
+    _remaining = 0;
+    _nextSlabSize = MinSlabSize;
+    _freeList = nullptr;
+}
+
+
+#endif //DATASTRUCTUREPROJECT_NODEALLOCATOR_HPP
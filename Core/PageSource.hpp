@@ -0,0 +1,292 @@
+//
+// Created on 2026/10/16 at 18:50.
+//
+
+#ifndef DATASTRUCTUREPROJECT_PAGESOURCE_HPP
+#define DATASTRUCTUREPROJECT_PAGESOURCE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "MappedFile.hpp"
+#include "Transcoder.hpp"
+
+#ifdef _MANAGED
+#include "Spider.hpp"
+#endif
+
+
+/// \brief Where the HTML pages of the documents come from.
+class PageSource
+{
+public:
+    /// \brief Get the HTML page of a document.
+    /// \param id Id of the document in url.csv.
+    /// \param url Url of the document.
+    /// \return Content of the page.
+    /// \throw std::exception if the page can not be got.
+    /// \note It is called by several threads at once.
+    virtual std::wstring GetHtml(int id, const std::wstring& url) const = 0;
+
+    /// \brief Open the page source at a path.
+    /// \param path A page archive, a directory of pages, or empty to download the pages.
+    /// \return The page source.
+    /// \throw std::runtime_error if the source can not be opened.
+    /// \note You need to delete the returning value after using it.
+    static PageSource* Open(const std::string& path);
+
+    virtual ~PageSource() = default;
+};
+
+
+/// \brief Reads pages from a directory, the page of document <code>id</code> is the file <code>id.html</code>.
+/// \note The encoding of a page is guessed by <code>Transcoder::DecodeHtml</code>.
+class DirectoryPageSource : public PageSource
+{
+public:
+    explicit DirectoryPageSource(const std::string& directory);
+
+    std::wstring GetHtml(int id, const std::wstring& url) const override;
+
+    /// \brief Get the path to the page of a document.
+    static std::string GetPagePath(const std::string& directory, int id);
+
+private:
+    std::string _directory;
+};
+
+
+/// \brief Reads pages from a memory-mapped archive packing the pages of a directory into one file.
+/// \note Layout of the file, all integers are little-endian:
+/// <ol>
+/// <li>A <code>Header</code>.</li>
+/// <li>The page table, one <code>PageEntry</code> per page, sorted by id.</li>
+/// <li>The pages as they were in the directory.</li>
+/// </ol>
+/// The pages are decoded straight from the mapping, so reading a page costs one decoding pass.
+/// The encoding of a page is guessed by <code>Transcoder::DecodeHtml</code>.
+class ArchivePageSource : public PageSource
+{
+public:
+    static const std::uint32_t Version = 1;
+
+    class Header
+    {
+    public:
+        char Magic[8];
+        std::uint32_t Version;
+        std::uint32_t PageCount;
+        std::uint64_t FileSize;
+    };
+
+    class PageEntry
+    {
+    public:
+        std::uint64_t Offset;
+        std::uint32_t Length;
+        std::int32_t Id;
+    };
+
+    /// \brief Map an archive written by <code>Pack</code>.
+    /// \param filePath Path to the archive.
+    /// \throw std::runtime_error if the file can not be mapped or is not a valid archive of this version.
+    explicit ArchivePageSource(const std::string& filePath);
+
+    std::wstring GetHtml(int id, const std::wstring& url) const override;
+
+    /// \brief Get the number of pages in the archive.
+    int GetPageCount() const;
+
+    /// \brief Pack the pages in a directory to an archive.
+    /// \param directory The directory, laid out as <code>DirectoryPageSource</code> reads.
+    /// \param ids Ids of the pages to pack, missing pages are skipped.
+    /// \param filePath Path to the archive, it will be overwritten.
+    /// \return The number of packed pages.
+    /// \throw std::runtime_error if the archive can not be written.
+    static int Pack(const std::string& directory, std::vector<int> ids, const std::string& filePath);
+
+    static const char* GetMagic()
+    {
+        return "DSPPAGES";
+    }
+
+private:
+    MappedFile _file;
+    const Header* _header = nullptr;
+    const PageEntry* _pages = nullptr;
+};
+
+
+#ifdef _MANAGED
+/// \brief Downloads the pages with <code>Spider</code>.
+class WebPageSource : public PageSource
+{
+public:
+    std::wstring GetHtml(int id, const std::wstring& url) const override;
+};
+
+
+inline std::wstring WebPageSource::GetHtml(int, const std::wstring& url) const
+{
+    return Spider::GetHtmlByUrl(url);
+}
+#endif
+
+
+inline PageSource* PageSource::Open(const std::string& path)
+{
+    if (path.empty())
+    {
+#ifdef _MANAGED
+        return new WebPageSource();
+#else
+        throw std::runtime_error("Pages can only be downloaded in managed builds in PageSource::Open()");
+#endif
+    }
+
+    // An archive starts with the magic, anything else is taken as a directory.
+    char magic[8] = {};
+    std::ifstream fin(path, std::ios::binary);
+    if (fin.read(magic, sizeof(magic)) && std::memcmp(magic, ArchivePageSource::GetMagic(), sizeof(magic)) == 0)
+    {
+        return new ArchivePageSource(path);
+    }
+
+    return new DirectoryPageSource(path);
+}
+
+
+inline DirectoryPageSource::DirectoryPageSource(const std::string& directory)
+    : _directory(directory)
+{
+}
+
+
+inline std::wstring DirectoryPageSource::GetHtml(const int id, const std::wstring&) const
+{
+    const MappedFile file(GetPagePath(_directory, id));
+    return Transcoder::DecodeHtml(reinterpret_cast<const char*>(file.GetData()), static_cast<int>(file.GetSize()));
+}
+
+
+inline std::string DirectoryPageSource::GetPagePath(const std::string& directory, const int id)
+{
+    return directory + "/" + std::to_string(id) + ".html";
+}
+
+
+inline ArchivePageSource::ArchivePageSource(const std::string& filePath)
+    : _file(filePath)
+{
+    const auto data = _file.GetData();
+    const auto size = static_cast<std::uint64_t>(_file.GetSize());
+
+    if (size < sizeof(Header))
+    {
+        throw std::runtime_error("File too small in ArchivePageSource::ArchivePageSource()");
+    }
+
+    _header = reinterpret_cast<const Header*>(data);
+
+    if (std::memcmp(_header->Magic, GetMagic(), sizeof(_header->Magic)) != 0 ||
+        _header->Version != Version || _header->FileSize != size ||
+        sizeof(Header) + sizeof(PageEntry) * static_cast<std::uint64_t>(_header->PageCount) > size)
+    {
+        throw std::runtime_error("Not a valid page archive in ArchivePageSource::ArchivePageSource()");
+    }
+
+    _pages = reinterpret_cast<const PageEntry*>(data + sizeof(Header));
+}
+
+
+inline std::wstring ArchivePageSource::GetHtml(const int id, const std::wstring&) const
+{
+    const auto end = _pages + _header->PageCount;
+    const auto page = std::lower_bound(_pages, end, id, [](const PageEntry& entry, const int target)-> bool
+    {
+        return entry.Id < target;
+    });
+
+    if (page == end || page->Id != id || page->Offset + page->Length > _header->FileSize)
+    {
+        throw std::runtime_error("Page not found in ArchivePageSource::GetHtml()");
+    }
+
+    return Transcoder::DecodeHtml(reinterpret_cast<const char*>(_file.GetData() + page->Offset),
+                                  static_cast<int>(page->Length));
+}
+
+
+inline int ArchivePageSource::GetPageCount() const
+{
+    return static_cast<int>(_header->PageCount);
+}
+
+
+inline int ArchivePageSource::Pack(const std::string& directory, std::vector<int> ids, const std::string& filePath)
+{
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+    // Only the sizes are read first, the pages are copied one by one when writing.
+    std::vector<PageEntry> entries;
+    for (const auto id : ids)
+    {
+        std::ifstream fin(DirectoryPageSource::GetPagePath(directory, id), std::ios::binary | std::ios::ate);
+        if (!fin)
+        {
+            continue;
+        }
+
+        PageEntry entry;
+        entry.Id = id;
+        entry.Length = static_cast<std::uint32_t>(fin.tellg());
+        entries.push_back(entry);
+    }
+
+    Header header;
+    std::memcpy(header.Magic, GetMagic(), sizeof(header.Magic));
+    header.Version = Version;
+    header.PageCount = static_cast<std::uint32_t>(entries.size());
+
+    auto offset = static_cast<std::uint64_t>(sizeof(Header) + sizeof(PageEntry) * entries.size());
+    for (auto& entry : entries)
+    {
+        entry.Offset = offset;
+        offset += entry.Length;
+    }
+
+    header.FileSize = offset;
+
+    std::ofstream fout(filePath, std::ios::binary | std::ios::trunc);
+    if (!fout)
+    {
+        throw std::runtime_error("Can not open file in ArchivePageSource::Pack()");
+    }
+
+    fout.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    fout.write(reinterpret_cast<const char*>(entries.data()), sizeof(PageEntry) * entries.size());
+    for (const auto& entry : entries)
+    {
+        // Inserting an empty buffer would fail the stream.
+        if (entry.Length > 0)
+        {
+            std::ifstream fin(DirectoryPageSource::GetPagePath(directory, entry.Id), std::ios::binary);
+            fout << fin.rdbuf();
+        }
+    }
+
+    if (!fout)
+    {
+        throw std::runtime_error("Can not write file in ArchivePageSource::Pack()");
+    }
+
+    return static_cast<int>(entries.size());
+}
+
+
+#endif //DATASTRUCTUREPROJECT_PAGESOURCE_HPP
@@ -0,0 +1,400 @@
+//
+// Created on 2026/10/16 at 10:05.
+//
+
+#ifndef DATASTRUCTUREPROJECT_POSTINGLIST_HPP
+#define DATASTRUCTUREPROJECT_POSTINGLIST_HPP
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+
+/// \brief A posting: a document and the times a word occurs in it.
+class Posting
+{
+public:
+    int DocumentId = 0;
+    int Frequency = 0;
+};
+
+
+/// \brief A compressed list of postings kept in ascending order of document id.
+/// \note Document ids are stored as varint-encoded deltas,
+/// the frequencies are stored as varints in a parallel block.
+/// Appending postings in ascending order of document id is O(1),
+/// adding a posting before the last one rebuilds the list.
+class PostingList
+{
+public:
+    class Iterator;
+
+    /// \brief Add occurrences of the word in a document.
+    /// \param documentId Id of the document, must not be negative.
+    /// \param frequency The times the word occurs in the document.
+    /// \return True if the document is new to the list, false if its frequency is accumulated.
+    bool Add(int documentId, int frequency);
+
+    /// \brief Merge all the postings of another list into the instance.
+    /// \param rhs The list to merge from. It is not modified.
+    /// \note Frequencies of documents appearing in both lists are accumulated.
+    void Merge(const PostingList& rhs);
+
+    /// \brief Get the number of postings in the list.
+    /// \return The number of postings in the list.
+    int GetLength() const;
+
+    /// \brief Get the maximum frequency of the postings.
+    /// \return The maximum frequency, 0 if the list is empty.
+    int GetMaxFrequency() const;
+
+    /// \brief Get the size of the encoded postings.
+    /// \return The number of bytes used by the two encoded blocks.
+    int GetEncodedSize() const;
+
+    /// \brief Get the encoded document deltas.
+    /// \return The block of varint-encoded deltas of the document ids.
+    const std::vector<unsigned char>& GetDocumentDeltas() const;
+
+    /// \brief Get the encoded frequencies.
+    /// \return The block of varint-encoded frequencies.
+    const std::vector<unsigned char>& GetFrequencies() const;
+
+    Iterator begin() const;
+    Iterator end() const;
+
+    /// \brief Append a value to a buffer as a varint.
+    /// \param buffer The buffer to append to.
+    /// \param value The value to encode.
+    static void WriteVarint(std::vector<unsigned char>& buffer, unsigned int value);
+
+    /// \brief Read a varint from a buffer.
+    /// \param position Pointer to the first byte of the varint, will be moved past the varint.
+    /// \param end Pointer past the last byte of the buffer.
+    /// \return The decoded value.
+    /// \throw std::runtime_error if the varint runs past the end of the buffer or does not fit in 32 bits.
+    static unsigned int ReadVarint(const unsigned char*& position, const unsigned char* end);
+
+private:
+    /// \brief Varint-encoded deltas of the document ids, the first one is the delta from 0.
+    std::vector<unsigned char> _documentDeltas;
+
+    /// \brief Varint-encoded frequencies, in the same order as the documents.
+    std::vector<unsigned char> _frequencies;
+
+    /// \brief The cached length.
+    int _length = 0;
+
+    /// \brief Document id of the last posting, -1 if the list is empty.
+    int _lastDocumentId = -1;
+
+    /// \brief Frequency of the last posting.
+    int _lastFrequency = 0;
+
+    /// \brief Offset of the frequency of the last posting in <code>_frequencies</code>.
+    int _lastFrequencyOffset = 0;
+
+    /// \brief The cached maximum frequency.
+    int _maxFrequency = 0;
+
+    /// \brief Append a posting whose document id is greater than all the others.
+    void Append(int documentId, int frequency);
+
+    /// \brief Replace the whole content of the list.
+    /// \param postings The postings sorted by document id, without duplicates.
+    void Assign(const std::vector<Posting>& postings);
+
+public:
+    /// \brief A forward iterator decoding the postings.
+    class Iterator
+    {
+    public:
+        /// \brief Construct an iterator over encoded blocks.
+        /// \param documentDeltas Pointer to the first byte of the document deltas.
+        /// \param documentDeltasLength The number of bytes of the document deltas.
+        /// \param frequencies Pointer to the first byte of the frequencies.
+        /// \param frequenciesLength The number of bytes of the frequencies.
+        /// \param length The number of postings in the blocks.
+        /// \note Decoding throws std::runtime_error instead of reading past the blocks if they are too short.
+        Iterator(const unsigned char* documentDeltas, const int documentDeltasLength,
+                 const unsigned char* frequencies, const int frequenciesLength, const int length)
+            : _documentDeltas(documentDeltas), _documentDeltasEnd(documentDeltas + documentDeltasLength),
+              _frequencies(frequencies), _frequenciesEnd(frequencies + frequenciesLength), _remaining(length)
+        {
+            if (_remaining > 0)
+            {
+                Decode();
+            }
+        }
+
+        const Posting& operator*() const
+        {
+            return _current;
+        }
+
+        const Posting* operator->() const
+        {
+            return &_current;
+        }
+
+        void operator++()
+        {
+            _remaining--;
+            if (_remaining > 0)
+            {
+                Decode();
+            }
+        }
+
+        void operator++(int)
+        {
+            ++(*this);
+        }
+
+        bool operator==(const Iterator& rhs) const
+        {
+            return _remaining == rhs._remaining;
+        }
+
+        bool operator!=(const Iterator& rhs) const
+        {
+            return _remaining != rhs._remaining;
+        }
+
+    private:
+        const unsigned char* _documentDeltas;
+        const unsigned char* _documentDeltasEnd;
+        const unsigned char* _frequencies;
+        const unsigned char* _frequenciesEnd;
+        int _remaining;
+        Posting _current;
+
+        void Decode()
+        {
+            _current.DocumentId += static_cast<int>(ReadVarint(_documentDeltas, _documentDeltasEnd));
+            _current.Frequency = static_cast<int>(ReadVarint(_frequencies, _frequenciesEnd));
+        }
+    };
+};
+
+
+inline bool PostingList::Add(const int documentId, const int frequency)
+{
+    if (documentId > _lastDocumentId)
+    {
+        Append(documentId, frequency);
+        return true;
+    }
+
+    if (documentId == _lastDocumentId)
+    {
+        // Re-encode the last frequency in place.
+        _lastFrequency += frequency;
+        _frequencies.resize(_lastFrequencyOffset);
+        WriteVarint(_frequencies, static_cast<unsigned int>(_lastFrequency));
+        _maxFrequency = std::max(_maxFrequency, _lastFrequency);
+        return false;
+    }
+
+    // The document comes before the last one, decode the list and insert it.
+    std::vector<Posting> postings;
+    postings.reserve(_length + 1);
+    for (const auto& posting : *this)
+    {
+        postings.push_back(posting);
+    }
+
+    Posting inserting;
+    inserting.DocumentId = documentId;
+    inserting.Frequency = frequency;
+
+    auto location = std::lower_bound(postings.begin(), postings.end(), inserting,
+                                     [](const Posting& lhs, const Posting& rhs)-> bool
+                                     {
+                                         return lhs.DocumentId < rhs.DocumentId;
+                                     }
+    );
+
+    auto isNew = true;
+    if (location != postings.end() && location->DocumentId == documentId)
+    {
+        location->Frequency += frequency;
+        isNew = false;
+    }
+    else
+    {
+        postings.insert(location, inserting);
+    }
+
+    Assign(postings);
+    return isNew;
+}
+
+
+inline void PostingList::Merge(const PostingList& rhs)
+{
+    if (rhs._length == 0)
+    {
+        return;
+    }
+
+    if (rhs.begin()->DocumentId > _lastDocumentId)
+    {
+        for (const auto& posting : rhs)
+        {
+            Append(posting.DocumentId, posting.Frequency);
+        }
+        return;
+    }
+
+    std::vector<Posting> postings;
+    postings.reserve(_length + rhs._length);
+
+    auto lhsWalker = begin();
+    auto rhsWalker = rhs.begin();
+
+    while (lhsWalker != end() && rhsWalker != rhs.end())
+    {
+        if (lhsWalker->DocumentId < rhsWalker->DocumentId)
+        {
+            postings.push_back(*lhsWalker);
+            ++lhsWalker;
+        }
+        else if (rhsWalker->DocumentId < lhsWalker->DocumentId)
+        {
+            postings.push_back(*rhsWalker);
+            ++rhsWalker;
+        }
+        else
+        {
+            auto merged = *lhsWalker;
+            merged.Frequency += rhsWalker->Frequency;
+            postings.push_back(merged);
+            ++lhsWalker;
+            ++rhsWalker;
+        }
+    }
+
+    for (; lhsWalker != end(); ++lhsWalker)
+    {
+        postings.push_back(*lhsWalker);
+    }
+
+    for (; rhsWalker != rhs.end(); ++rhsWalker)
+    {
+        postings.push_back(*rhsWalker);
+    }
+
+    Assign(postings);
+}
+
+
+inline int PostingList::GetLength() const
+{
+    return _length;
+}
+
+
+inline int PostingList::GetMaxFrequency() const
+{
+    return _maxFrequency;
+}
+
+
+inline int PostingList::GetEncodedSize() const
+{
+    return static_cast<int>(_documentDeltas.size() + _frequencies.size());
+}
+
+
+inline const std::vector<unsigned char>& PostingList::GetDocumentDeltas() const
+{
+    return _documentDeltas;
+}
+
+
+inline const std::vector<unsigned char>& PostingList::GetFrequencies() const
+{
+    return _frequencies;
+}
+
+
+inline PostingList::Iterator PostingList::begin() const
+{
+    return Iterator(_documentDeltas.data(), static_cast<int>(_documentDeltas.size()), _frequencies.data(),
+                    static_cast<int>(_frequencies.size()), _length);
+}
+
+
+inline PostingList::Iterator PostingList::end() const
+{
+    return Iterator(nullptr, 0, nullptr, 0, 0);
+}
+
+
+inline void PostingList::WriteVarint(std::vector<unsigned char>& buffer, unsigned int value)
+{
+    while (value >= 0x80)
+    {
+        buffer.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+
+    buffer.push_back(static_cast<unsigned char>(value));
+}
+
+
+inline unsigned int PostingList::ReadVarint(const unsigned char*& position, const unsigned char* end)
+{
+    auto value = 0u;
+    auto shift = 0;
+
+    // A 32-bit value takes at most 5 bytes, the shift of the last one is 28.
+    while (position != end && shift <= 28)
+    {
+        const auto byte = *position++;
+        value |= static_cast<unsigned int>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            return value;
+        }
+
+        shift += 7;
+    }
+
+    throw std::runtime_error("Corrupted varint in PostingList::ReadVarint()");
+}
+
+
+inline void PostingList::Append(const int documentId, const int frequency)
+{
+    WriteVarint(_documentDeltas, static_cast<unsigned int>(documentId - (_lastDocumentId < 0 ? 0 : _lastDocumentId)));
+
+    _lastFrequencyOffset = static_cast<int>(_frequencies.size());
+    WriteVarint(_frequencies, static_cast<unsigned int>(frequency));
+
+    _lastDocumentId = documentId;
+    _lastFrequency = frequency;
+    _maxFrequency = std::max(_maxFrequency, frequency);
+    _length++;
+}
+
+
+inline void PostingList::Assign(const std::vector<Posting>& postings)
+{
+    _documentDeltas.clear();
+    _frequencies.clear();
+    _length = 0;
+    _lastDocumentId = -1;
+    _lastFrequency = 0;
+    _lastFrequencyOffset = 0;
+    _maxFrequency = 0;
+
+    for (const auto& posting : postings)
+    {
+        Append(posting.DocumentId, posting.Frequency);
+    }
+}
+
+
+#endif //DATASTRUCTUREPROJECT_POSTINGLIST_HPP
@@ -0,0 +1,290 @@
+//
+// Created on 2026/10/16 at 16:40.
+//
+
+#ifndef DATASTRUCTUREPROJECT_SIMD_HPP
+#define DATASTRUCTUREPROJECT_SIMD_HPP
+
+// SSE2 is used when the target is known to have it, otherwise the scalar versions are compiled.
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DATASTRUCTUREPROJECT_USE_SSE2
+#endif
+
+#ifdef DATASTRUCTUREPROJECT_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Vector types are not supported in managed code, keep these functions native.
+#ifdef _MANAGED
+#pragma managed(push, off)
+#endif
+
+
+/// \brief A set of small vector routines, each has a scalar fallback.
+class Simd
+{
+public:
+    /// \brief The number of bytes processed at once.
+    static const int GroupWidth = 16;
+
+    /// \brief The number of wide characters processed at once.
+    static const int CharGroupWidth = GroupWidth / sizeof(wchar_t);
+
+    /// \brief Find the bytes equal to a value in a group.
+    /// \param group Pointer to <code>GroupWidth</code> bytes, need not be aligned.
+    /// \param value The value to find.
+    /// \return A mask whose bit i is set if <code>group[i] == value</code>.
+    static unsigned int MatchByte(const unsigned char* group, unsigned char value);
+
+    /// \brief Find the bytes whose highest bit is set in a group.
+    /// \param group Pointer to <code>GroupWidth</code> bytes, need not be aligned.
+    /// \return A mask whose bit i is set if <code>group[i] &gt;= 0x80</code>.
+    static unsigned int MatchHighBit(const unsigned char* group);
+
+    /// \brief Find the wide characters equal to a value in a group.
+    /// \param group Pointer to <code>CharGroupWidth</code> characters, need not be aligned.
+    /// \param value The value to find.
+    /// \return A mask whose bit i is set if <code>group[i] == value</code>.
+    static unsigned int MatchChar(const wchar_t* group, wchar_t value);
+
+    /// \brief Find the first occurrence of a wide character.
+    /// \param data Pointer to the characters.
+    /// \param length The number of characters.
+    /// \param value The value to find.
+    /// \return Index of the first character equal to <code>value</code>, <code>length</code> if there is none.
+    /// \note Two groups are tested a step, so a run without the character costs one branch per block.
+    static int FindChar(const wchar_t* data, int length, wchar_t value);
+
+    /// \brief Find the positions where two groups of wide characters both equal their values.
+    /// \param group Pointer to <code>CharGroupWidth</code> characters, need not be aligned.
+    /// \param value The value to find in <code>group</code>.
+    /// \param otherGroup Pointer to <code>CharGroupWidth</code> characters, need not be aligned.
+    /// \param otherValue The value to find in <code>otherGroup</code>.
+    /// \return A mask whose bit i is set if <code>group[i] == value && otherGroup[i] == otherValue</code>.
+    static unsigned int MatchCharPair(const wchar_t* group, wchar_t value,
+                                      const wchar_t* otherGroup, wchar_t otherValue);
+
+    /// \brief Widen the leading ASCII bytes to wide characters.
+    /// \param data Pointer to the bytes.
+    /// \param length The number of bytes.
+    /// \param output Where to write the characters, it must have room for <code>length</code> characters.
+    /// \return The number of leading bytes below 0x80, they are widened.
+    /// \note The characters after the returned count may be overwritten, but not those after <code>length</code>.
+    static int WidenAscii(const unsigned char* data, int length, wchar_t* output);
+
+    /// \brief Get the index of the lowest set bit.
+    /// \param mask The mask, must not be 0.
+    /// \return The index of the lowest set bit.
+    static int CountTrailingZeros(unsigned int mask);
+};
+
+
+inline unsigned int Simd::MatchByte(const unsigned char* group, const unsigned char value)
+{
+#ifdef DATASTRUCTUREPROJECT_USE_SSE2
+    const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    const auto values = _mm_set1_epi8(static_cast<char>(value));
+    return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, values)));
+#else
+    auto mask = 0u;
+    for (auto i = 0; i < GroupWidth; i++)
+    {
+        if (group[i] == value)
+        {
+            mask |= 1u << i;
+        }
+    }
+
+    return mask;
+#endif
+}
+
+
+inline unsigned int Simd::MatchHighBit(const unsigned char* group)
+{
+#ifdef DATASTRUCTUREPROJECT_USE_SSE2
+    const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<unsigned int>(_mm_movemask_epi8(bytes));
+#else
+    auto mask = 0u;
+    for (auto i = 0; i < GroupWidth; i++)
+    {
+        if (group[i] & 0x80)
+        {
+            mask |= 1u << i;
+        }
+    }
+
+    return mask;
+#endif
+}
+
+
+inline unsigned int Simd::MatchChar(const wchar_t* group, const wchar_t value)
+{
+#ifdef DATASTRUCTUREPROJECT_USE_SSE2
+    const auto characters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    const auto zero = _mm_setzero_si128();
+
+    if (sizeof(wchar_t) == 2)
+    {
+        const auto equal = _mm_cmpeq_epi16(characters, _mm_set1_epi16(static_cast<short>(value)));
+        return static_cast<unsigned int>(_mm_movemask_epi8(_mm_packs_epi16(equal, zero)));
+    }
+
+    const auto equal = _mm_cmpeq_epi32(characters, _mm_set1_epi32(static_cast<int>(value)));
+    return static_cast<unsigned int>(_mm_movemask_epi8(_mm_packs_epi16(_mm_packs_epi32(equal, zero), zero)));
+#else
+    auto mask = 0u;
+    for (auto i = 0; i < CharGroupWidth; i++)
+    {
+        if (group[i] == value)
+        {
+            mask |= 1u << i;
+        }
+    }
+
+    return mask;
+#endif
+}
+
+
+inline int Simd::FindChar(const wchar_t* data, const int length, const wchar_t value)
+{
+    auto index = 0;
+
+#ifdef DATASTRUCTUREPROJECT_USE_SSE2
+    while (length - index >= CharGroupWidth * 2)
+    {
+        const auto mask = MatchChar(data + index, value) |
+            MatchChar(data + index + CharGroupWidth, value) << CharGroupWidth;
+        if (mask != 0)
+        {
+            return index + CountTrailingZeros(mask);
+        }
+
+        index += CharGroupWidth * 2;
+    }
+#endif
+
+    while (index < length && data[index] != value)
+    {
+        index++;
+    }
+
+    return index;
+}
+
+
+inline unsigned int Simd::MatchCharPair(const wchar_t* group, const wchar_t value,
+                                        const wchar_t* otherGroup, const wchar_t otherValue)
+{
+#ifdef DATASTRUCTUREPROJECT_USE_SSE2
+    const auto characters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    const auto otherCharacters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(otherGroup));
+    const auto zero = _mm_setzero_si128();
+
+    // Each character is narrowed to one byte of the mask with saturating packs, -1 stays -1.
+    if (sizeof(wchar_t) == 2)
+    {
+        const auto equal = _mm_and_si128(
+            _mm_cmpeq_epi16(characters, _mm_set1_epi16(static_cast<short>(value))),
+            _mm_cmpeq_epi16(otherCharacters, _mm_set1_epi16(static_cast<short>(otherValue))));
+        return static_cast<unsigned int>(_mm_movemask_epi8(_mm_packs_epi16(equal, zero)));
+    }
+
+    const auto equal = _mm_and_si128(
+        _mm_cmpeq_epi32(characters, _mm_set1_epi32(static_cast<int>(value))),
+        _mm_cmpeq_epi32(otherCharacters, _mm_set1_epi32(static_cast<int>(otherValue))));
+    return static_cast<unsigned int>(_mm_movemask_epi8(_mm_packs_epi16(_mm_packs_epi32(equal, zero), zero)));
+#else
+    auto mask = 0u;
+    for (auto i = 0; i < CharGroupWidth; i++)
+    {
+        if (group[i] == value && otherGroup[i] == otherValue)
+        {
+            mask |= 1u << i;
+        }
+    }
+
+    return mask;
+#endif
+}
+
+
+inline int Simd::WidenAscii(const unsigned char* data, const int length, wchar_t* output)
+{
+    auto widened = 0;
+
+#ifdef DATASTRUCTUREPROJECT_USE_SSE2
+    const auto zero = _mm_setzero_si128();
+    while (length - widened >= GroupWidth)
+    {
+        const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + widened));
+        const auto low = _mm_unpacklo_epi8(bytes, zero);
+        const auto high = _mm_unpackhi_epi8(bytes, zero);
+        const auto writing = reinterpret_cast<__m128i*>(output + widened);
+
+        // The whole group is written, the non-ASCII part is overwritten by the caller.
+        if (sizeof(wchar_t) == 2)
+        {
+            _mm_storeu_si128(writing, low);
+            _mm_storeu_si128(writing + 1, high);
+        }
+        else
+        {
+            _mm_storeu_si128(writing, _mm_unpacklo_epi16(low, zero));
+            _mm_storeu_si128(writing + 1, _mm_unpackhi_epi16(low, zero));
+            _mm_storeu_si128(writing + 2, _mm_unpacklo_epi16(high, zero));
+            _mm_storeu_si128(writing + 3, _mm_unpackhi_epi16(high, zero));
+        }
+
+        const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(bytes));
+        if (mask != 0)
+        {
+            return widened + CountTrailingZeros(mask);
+        }
+
+        widened += GroupWidth;
+    }
+#endif
+
+    while (widened < length && data[widened] < 0x80)
+    {
+        output[widened] = static_cast<wchar_t>(data[widened]);
+        widened++;
+    }
+
+    return widened;
+}
+
+
+inline int Simd::CountTrailingZeros(const unsigned int mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#elif defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else
+    auto index = 0;
+    while (!(mask & (1u << index)))
+    {
+        index++;
+    }
+
+    return index;
+#endif
+}
+
+
+#ifdef _MANAGED
+#pragma managed(pop)
+#endif
+
+#endif //DATASTRUCTUREPROJECT_SIMD_HPP
@@ -6,13 +6,17 @@
 #define DATASTRUCTUREPROJECT_SORTEDLIST_HPP
 
 #include <functional>
+#include <type_traits>
+#include <utility>
+#include "NodeAllocator.hpp"
 
 
 /// \brief A linked list which keeps sorted.
 /// \tparam TElement Type of the element.
 /// \tparam TLess A Function returning a boolean value to determine the order of the elements.
 /// Will be called like <code>less(elem1, elem2)</code>, meaning elem1 &lt; elem2 if it returns true.
-template <typename TElement, typename TLess>
+/// \tparam TAllocator The allocator of the nodes, <code>HeapNodeAllocator</code> or <code>ArenaNodeAllocator</code>.
+template <typename TElement, typename TLess, template <typename> class TAllocator = HeapNodeAllocator>
 class SortedList
 {
 private:
@@ -61,6 +65,19 @@ private:
     LinkedListNode* _head = nullptr;
     LinkedListNode* _tail = nullptr;
 
+    TAllocator<LinkedListNode> _allocator;
+
+    /// \brief Destroy all the nodes.
+    void Clear()
+    {
+        while (_head != nullptr)
+        {
+            auto next = _head->Next;
+            _allocator.Destroy(_head);
+            _head = next;
+        }
+    }
+
 public:
     SortedList() = default;
 
@@ -71,30 +88,23 @@ public:
 
     void operator=(const SortedList& rhs)
     {
-        if (rhs._head != nullptr)
+        if (this == &rhs)
         {
-            while (_head != nullptr)
-            {
-                auto next = _head->Next;
-                delete _head;
-                _head = next;
-            }
-
-            _head = new LinkedListNode(rhs._head->Element);
+            return;
         }
 
-        auto sourceWalker = rhs._head->Next;
-        auto destinationWalker = _head;
-        while (sourceWalker != nullptr)
+        Clear();
+
+        auto link = &_head;
+        for (auto sourceWalker = rhs._head; sourceWalker != nullptr; sourceWalker = sourceWalker->Next)
         {
-            destinationWalker->Next = new LinkedListNode(sourceWalker->Element);
-            sourceWalker = sourceWalker->Next;
-            destinationWalker = destinationWalker->Next;
+            *link = _allocator.Create(sourceWalker->Element);
+            link = &((*link)->Next);
         }
     }
 
     SortedList(SortedList&& rhs) noexcept
-        : _head(rhs._head)
+        : _head(rhs._head), _allocator(std::move(rhs._allocator))
     {
         rhs._head = nullptr;
     }
@@ -148,22 +158,22 @@ public:
 };
 
 
-template <typename TElement, typename TLess>
-typename SortedList<TElement, TLess>::Iterator SortedList<TElement, TLess>::begin()
+template <typename TElement, typename TLess, template <typename> class TAllocator>
+typename SortedList<TElement, TLess, TAllocator>::Iterator SortedList<TElement, TLess, TAllocator>::begin()
 {
     return Iterator(_head);
 }
 
 
-template <typename TElement, typename TLess>
-typename SortedList<TElement, TLess>::Iterator SortedList<TElement, TLess>::end()
+template <typename TElement, typename TLess, template <typename> class TAllocator>
+typename SortedList<TElement, TLess, TAllocator>::Iterator SortedList<TElement, TLess, TAllocator>::end()
 {
     return Iterator(_tail);
 }
 
 
-template <typename TElement, typename TLess>
-typename SortedList<TElement, TLess>::Iterator SortedList<TElement, TLess>::FirstOf(
+template <typename TElement, typename TLess, template <typename> class TAllocator>
+typename SortedList<TElement, TLess, TAllocator>::Iterator SortedList<TElement, TLess, TAllocator>::FirstOf(
     const std::function<bool(const TElement&)>& prediction
 )
 {
@@ -179,19 +189,19 @@ typename SortedList<TElement, TLess>::Iterator SortedList<TElement, TLess>::Firs
 }
 
 
-template <typename TElement, typename TLess>
-void SortedList<TElement, TLess>::Insert(const TElement& element)
+template <typename TElement, typename TLess, template <typename> class TAllocator>
+void SortedList<TElement, TLess, TAllocator>::Insert(const TElement& element)
 {
     if (_head == nullptr)
     {
-        _head = new LinkedListNode(element);
+        _head = _allocator.Create(element);
         return;
     }
 
     if (TLess()(element, _head->Element))
     {
         auto temp = _head;
-        _head = new LinkedListNode(element);
+        _head = _allocator.Create(element);
         _head->Next = temp;
         return;
     }
@@ -205,13 +215,13 @@ void SortedList<TElement, TLess>::Insert(const TElement& element)
         slow = slow->Next;
     }
 
-    slow->Next = new LinkedListNode(element);
+    slow->Next = _allocator.Create(element);
     slow->Next->Next = fast;
 }
 
 
-template <typename TElement, typename TLess>
-void SortedList<TElement, TLess>::RemoveFirstOf(const std::function<bool(const TElement&)>& prediction)
+template <typename TElement, typename TLess, template <typename> class TAllocator>
+void SortedList<TElement, TLess, TAllocator>::RemoveFirstOf(const std::function<bool(const TElement&)>& prediction)
 {
     if (_head == nullptr)
     {
@@ -222,7 +232,7 @@ void SortedList<TElement, TLess>::RemoveFirstOf(const std::function<bool(const T
     {
         auto temp = _head;
         _head = _head->Next;
-        delete temp;
+        _allocator.Destroy(temp);
         return;
     }
 
@@ -241,13 +251,13 @@ void SortedList<TElement, TLess>::RemoveFirstOf(const std::function<bool(const T
     }
 
     slow->Next = fast->Next;
-    delete fast;
+    _allocator.Destroy(fast);
 }
 
 
-template <typename TElement, typename TLess>
-void SortedList<TElement, TLess>::Modify(
-    const typename Iterator& iterator, const std::function<void(TElement&)>& modification
+template <typename TElement, typename TLess, template <typename> class TAllocator>
+void SortedList<TElement, TLess, TAllocator>::Modify(
+    const Iterator& iterator, const std::function<void(TElement&)>& modification
 )
 {
     modification(*iterator);
@@ -304,14 +314,13 @@ void SortedList<TElement, TLess>::Modify(
 }
 
 
-template <typename TElement, typename TLess>
-SortedList<TElement, TLess>::~SortedList()
+template <typename TElement, typename TLess, template <typename> class TAllocator>
+SortedList<TElement, TLess, TAllocator>::~SortedList()
 {
-    while (_head != nullptr)
+    // The arena frees the nodes at once, only the elements may need to be destroyed one by one.
+    if (!TAllocator<LinkedListNode>::ReleasesAll || !std::is_trivially_destructible<TElement>::value)
     {
-        auto next = _head->Next;
-        delete _head;
-        _head = next;
+        Clear();
     }
 }
 
@@ -6,19 +6,30 @@
 #include <fstream>
 #include <iomanip>
 #include <omp.h>
+#include <stdexcept>
 #include <vector>
-#include "Spider.hpp"
 #include "Dictionary.hpp"
 #include "Document.hpp"
 
 #ifdef DATASTRUCTUREPROJECT_USE_AVL_II
 #include "AvlTreeInvertedIndex.hpp"
+using InvertedIndex = AvlTreeInvertedIndex;
 #else
 #include "HashMapInvertedIndex.hpp"
+using InvertedIndex = HashMapInvertedIndex;
 #endif
 
+#include "InvertedIndexShards.hpp"
+#include "IndexFile.hpp"
 #include "CsvUtility.hpp"
+#include "PageSource.hpp"
+#include "Transcoder.hpp"
+#include "Benchmark.hpp"
+
+#ifdef _MANAGED
+#include "Spider.hpp"
 #include "GuiCore.hpp"
+#endif
 
 using namespace std;
 
@@ -27,60 +38,278 @@ class IntHasher
 public:
     int operator()(const int i) const
     {
-        return i % (HashMax - HashMin);
+        return i;
     }
-
-    static const int HashMax = 100000;
-    static const int HashMin = 0;
 };
 
 
-int main()
+/// \brief Write the documents matching a query, as (id,occurrence) pairs.
+void WriteQueryResult(wofstream& fout, LinkedList<pair<int, int>>& result)
 {
-    const locale loc("chs");
+    result.Iterate([&fout](const pair<int, int>& item)->void
+    {
+        fout << L'(' << item.first << L',' << item.second << L") ";
+    });
+}
 
-    auto dict = new Dictionary();
 
-    cout << "Constructing dictionaries, please wait.\n";
-    dict->AddDictionary("./Professional.dic");
-    dict->AddDictionary("./Universal.dic");
+/// \brief Write the documents matching a query, as (id,occurrence) pairs.
+template <typename TResult>
+void WriteQueryResult(wofstream& fout, TResult& result)
+{
+    result.Travelsal(
+        [&fout](const int& id, const int& times)-> void
+    {
+        fout << L'(' << id << L',' << times << L") ";
+    }
+    );
+}
 
-    // No memory leak until here.
 
-    wifstream fin;
+/// \brief Print the memory the titles, the contents and the indexed words take in UTF-8,
+/// and what they would take as <code>wchar_t</code>.
+/// \param invertedIndex The built index.
+/// \param documents The indexed documents.
+template <typename TInvertedIndex>
+void ReportTextMemory(TInvertedIndex& invertedIndex, const vector<const Document*>& documents)
+{
+    long long documentBytes = 0;
+    long long documentWideBytes = 0;
+    for (const auto document : documents)
+    {
+        documentBytes += document->PostTitle.GetByteLength() + document->PostContent.GetByteLength();
+        documentWideBytes += (document->PostTitle.GetWideLength() + document->PostContent.GetWideLength()) *
+            static_cast<long long>(sizeof(wchar_t));
+    }
+
+    long long wordBytes = 0;
+    long long wordWideBytes = 0;
+    invertedIndex.Iterate([&wordBytes, &wordWideBytes](const Utf8String& word, const InvertedIndexNode&)-> void
+    {
+        // The term table holds each word once, its shard only holds the term id.
+        wordBytes += word.GetByteLength();
+        wordWideBytes += word.GetWideLength() * static_cast<long long>(sizeof(wchar_t));
+    });
+
+    cout << "Titles and contents take " << documentBytes / 1024 << " KiB in UTF-8 ("
+        << documentWideBytes / 1024 << " KiB as wchar_t), indexed words take " << wordBytes / 1024
+        << " KiB (" << wordWideBytes / 1024 << " KiB).\n";
+}
+
+
+/// \brief Perform the queries in query.txt and write the results to result.txt.
+/// \param invertedIndex The index to query.
+/// \param topK The number of documents ranked by BM25 to write for each query, 0 to write all the matches.
+/// \note query.txt is in GBK.
+template <typename TInvertedIndex>
+void PerformQueries(TInvertedIndex& invertedIndex, const int topK)
+{
     wofstream fout;
-    wstring finReader;
 
-    fin.imbue(loc);
-    fout.imbue(loc);
+    fout.imbue(locale::classic());
+    fout.open("result.txt");
+
+    auto queryCount = 0;
+
+    for (const auto& line : Transcoder::ReadLines("query.txt", Transcoder::Encoding::Gb18030))
+    {
+        cout << "Performing query #" << queryCount;
+
+        const CharString cs(line);
+        const auto slices = Split(cs, L' ');
+
+        if (topK > 0)
+        {
+            invertedIndex.QueryTopK(slices, topK).Iterate([&fout](const pair<int, double>& item)->void
+            {
+                fout << L'(' << item.first << L',' << item.second << L") ";
+            });
+
+            fout << endl;
+            queryCount++;
+            continue;
+        }
+
+        auto result = invertedIndex.Query(slices);
+        WriteQueryResult(fout, result);
+
+        fout << endl;
+        queryCount++;
+    }
+}
+
+
+/// \brief Parse a count given on the command line.
+/// \param text The argument, all of it needs to be the number.
+/// \param value Set to the number if it is valid.
+/// \return Whether the argument is a number of at least 1.
+bool TryParseCount(const char* text, int& value)
+{
+    try
+    {
+        size_t length = 0;
+        const auto parsed = stoi(text, &length);
+        if (text[length] != '\0' || parsed < 1)
+        {
+            return false;
+        }
+
+        value = parsed;
+        return true;
+    }
+    catch (const logic_error&)
+    {
+        // stoi throws invalid_argument if there is no number and out_of_range if it overflows.
+        return false;
+    }
+}
+
+
+int main(int argc, char* argv[])
+{
+    // With --threads and --top, the count needs to be at least 1.
+    // With --top, only the best k documents ranked by BM25 are written for each query.
+    // With --index, the index is loaded from the file if it exists, otherwise it is built and saved there.
+    // With --pages, the pages are read from a page archive or a directory of <id>.html instead of downloaded.
+    // With --pack, the pages in the --pages directory are packed to an archive and nothing else is done.
+    // With --benchmark, only the named benchmark is run: hash reports the collisions of the dictionary words,
+    // lookup times the inline tags and stop words on the first page in url.csv, read from --pages.
+    const auto usage =
+        "Usage: Core [--threads n] [--top k] [--index path] [--pages path] [--pack path] [--benchmark name]\n";
+    auto threadCount = 16;
+    auto topK = 0;
+    string indexPath;
+    string pagesPath;
+    string packPath;
+    string benchmarkName;
+    for (auto i = 1; i + 1 < argc; i++)
+    {
+        if (string(argv[i]) == "--threads")
+        {
+            if (!TryParseCount(argv[i + 1], threadCount))
+            {
+                cout << usage;
+                return 1;
+            }
+        }
+        else if (string(argv[i]) == "--top")
+        {
+            if (!TryParseCount(argv[i + 1], topK))
+            {
+                cout << usage;
+                return 1;
+            }
+        }
+        else if (string(argv[i]) == "--index")
+        {
+            indexPath = argv[i + 1];
+        }
+        else if (string(argv[i]) == "--pages")
+        {
+            pagesPath = argv[i + 1];
+        }
+        else if (string(argv[i]) == "--pack")
+        {
+            packPath = argv[i + 1];
+        }
+        else if (string(argv[i]) == "--benchmark")
+        {
+            benchmarkName = argv[i + 1];
+        }
+    }
+
+    if (benchmarkName == "hash")
+    {
+        Benchmark::ReportHashCollisions({"./Professional.dic", "./Universal.dic"});
+        return 0;
+    }
 
-    // Read urls and save them in a vector.
-    fin.open(L"./url.csv");
+    if (benchmarkName == "lookup")
+    {
+        const auto lines = Transcoder::ReadLines("./url.csv", Transcoder::Encoding::Gb18030);
+        if (lines.size() < 2)
+        {
+            cout << "No url in url.csv.\n";
+            return 1;
+        }
+
+        auto list = CsvUtility::CsvDecode(CharString(lines[1]));
+        const auto id = stoi(list.GetItemAt(0).ToStdWstring());
+        const auto& quotedUrl = list.GetItemAt(1);
+        const auto url = quotedUrl.GetSubview(1, quotedUrl.GetLength() - 1);
 
-    getline(fin, finReader);
+        const auto pageSource = PageSource::Open(pagesPath);
+        Benchmark::ReportLookups(pageSource->GetHtml(id, url.ToStdWstring()));
+        delete pageSource;
+        return 0;
+    }
 
-    vector<wstring> urls;
-    urls.reserve(2000);
+    if (!indexPath.empty() && ifstream(indexPath).good())
+    {
+        const auto loadStart = omp_get_wtime();
+        MappedInvertedIndex mappedIndex(indexPath);
+        cout << "Index loaded from " << indexPath << " in " << fixed << setprecision(3)
+            << omp_get_wtime() - loadStart << "s.\n";
+
+        PerformQueries(mappedIndex, topK);
+        return 0;
+    }
+
+    auto dict = new Dictionary();
+
+    cout << "Constructing dictionaries, please wait.\n";
+    dict->AddDictionary("./Professional.dic");
+    dict->AddDictionary("./Universal.dic");
+
+    // No memory leak until here.
+
+    // Read urls and save them in a vector, the first line is the header.
     cout << "Reading urls.\n";
+    auto urls = Transcoder::ReadLines("./url.csv", Transcoder::Encoding::Gb18030);
+    if (!urls.empty())
+    {
+        urls.erase(urls.begin());
+    }
 
-    while (getline(fin, finReader, L'\n'))
+    if (!packPath.empty())
     {
-        urls.push_back(finReader);
+        vector<int> ids;
+        for (const auto& line : urls)
+        {
+            ids.push_back(stoi(CsvUtility::CsvDecode(CharString(line)).GetItemAt(0).ToStdWstring()));
+        }
+
+        const auto packed = ArchivePageSource::Pack(pagesPath, ids, packPath);
+        cout << packed << " pages packed to " << packPath << ".\n";
+
+        delete dict;
+        return 0;
     }
 
+    const auto pageSource = PageSource::Open(pagesPath);
+
     // Download documents.
 
 #ifdef DATASTRUCTUREPROJECT_USE_AVL_II
     AvlTree<int, Document*, less<int>> allDocuments;
     AvlTreeInvertedIndex invertedIndex;
 #else
-    HashMap<int, Document*, IntHasher, IntHasher::HashMin, IntHasher::HashMax> allDocuments;
+    FlatHashMap<int, Document*, IntHasher> allDocuments;
     HashMapInvertedIndex invertedIndex;
 #endif
 
+    // Each thread indexes into its own shard, the first shard is the final index.
+    vector<InvertedIndex*> shards(threadCount);
+    shards[0] = &invertedIndex;
+    for (auto i = 1; i < threadCount; i++)
+    {
+        shards[i] = new InvertedIndex();
+    }
+
     const auto size = urls.size();
+    const auto buildStart = omp_get_wtime();
 
-#pragma omp parallel for num_threads(16)
+#pragma omp parallel for num_threads(threadCount)
     for (auto i = 0; i < static_cast<int>(size); i++)
     {
         // Parse this line.
@@ -88,15 +317,16 @@ int main()
         auto list = CsvUtility::CsvDecode(cs);
 
         const auto id = stoi(list.GetItemAt(0).ToStdWstring());
-        auto url = list.GetItemAt(1);
-        url = url.GetSubstring(1, url.GetLength() - 1);
+        const auto& quotedUrl = list.GetItemAt(1);
+        const auto url = quotedUrl.GetSubview(1, quotedUrl.GetLength() - 1);
 
         auto document = new Document();
 
         try
         {
             document->AssignId(id);
-            document->UpdateFromUrl(url.ToStdWstring(), *dict);
+            const CharString html(pageSource->GetHtml(id, url.ToStdWstring()));
+            document->UpdateFromHtml(html, *dict);
         }
         catch (const exception&)
         {
@@ -113,69 +343,53 @@ int main()
             allDocuments.Insert(document->Id, document);
         }
 
-        auto& wordList = document->Words;
+        auto& shard = *shards[omp_get_thread_num()];
+        shard.AddDocument(document);
+    }
 
-#ifdef DATASTRUCTUREPROJECT_USE_AVL_II
-        AvlTree<CharString, int, less<CharString>> countedWords;
-#else
-        HashMap<CharString, int, CharString::Hasher, CharString::HashMin, CharString::HashMax> countedWords;
-#endif
+    const auto mergeStart = omp_get_wtime();
+    InvertedIndexShards::Reduce(shards);
 
-        for (const auto& word : wordList)
-        {
-            if (!countedWords.Contains(word))
-            {
-                countedWords.Insert(word, 0);
-                const auto increase = document->CountWords(word);
-#pragma omp critical
-                {
-                    invertedIndex.AddOccurrence(word, document, increase);
-                }
-            }
-        }
+    for (auto i = 1; i < threadCount; i++)
+    {
+        delete shards[i];
     }
 
+    const auto buildEnd = omp_get_wtime();
+    cout << "Index built with " << threadCount << " threads in " << fixed << setprecision(3)
+        << buildEnd - buildStart << "s (merging " << buildEnd - mergeStart << "s).\n";
+
     delete dict;
     dict = nullptr;
+    delete pageSource;
 
     // Now we have constructed the inverted index.
     // This is the console application. We need to load the queries and perform them.
 
-    fin.close();
-    fin.open(L"query.txt");
-
-    fout.imbue(locale::classic());
-    fout.open(L"result.txt");
-
-    auto queryCount = 0;
-
-    while (getline(fin, finReader))
+    vector<const Document*> documents;
+    const function<void(const int&, Document* const &)> collectFunction =
+        [&documents](const int&, Document* const& document)-> void
     {
-        cout << "Performing query #" << queryCount;
-
-        const CharString cs(finReader);
-        const auto slices = Split(cs, L' ');
-        auto result = invertedIndex.Query(slices);
+        documents.push_back(document);
+    };
 
 #ifdef DATASTRUCTUREPROJECT_USE_AVL_II
-        result.Iterate([&fout](const pair<int, int>& item)->void
-        {
-            fout << L'(' << item.first << L',' << item.second << L") ";
-        });
+    allDocuments.InorderTraversal(collectFunction);
 #else
-        result.Travelsal(
-            [&fout](const int& id, const int& times)-> void
-        {
-            fout << L'(' << id << L',' << times << L") ";
-        }
-        );
+    allDocuments.Travelsal(collectFunction);
 #endif
 
-        fout << endl;
-        queryCount++;
+    ReportTextMemory(invertedIndex, documents);
+
+    if (!indexPath.empty())
+    {
+        IndexFile::Save(indexPath, invertedIndex, documents);
+        cout << "Index saved to " << indexPath << ".\n";
     }
 
-    const function<void(const int&, Document* const &)> deleteFunction = [](const int& id, Document*const& document)->void
+    PerformQueries(invertedIndex, topK);
+
+    const function<void(const int&, Document* const &)> deleteFunction = [](const int&, Document*const& document)->void
     {
         delete document;
     };
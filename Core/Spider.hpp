@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include "Transcoder.hpp"
 
 #using "Utilities.dll"
 
@@ -8,34 +9,39 @@ class Spider
 {
 public:
     static std::wstring GetHtmlByUrl(const std::wstring& url);
-    static std::wstring GetDecodedHtml(const std::wstring& html);
     static void GenerateWordCloud(const std::wstring& csvFilePath, const std::wstring& savingFilePath);
 };
 
 
 std::wstring Spider::GetHtmlByUrl(const std::wstring& url)
 {
-    System::String ^ html = Utilities::Utilities::GetHtmlByUrl(gcnew System::String(url.c_str()));
-    const wchar_t* chars = (const wchar_t *)(System::Runtime::InteropServices::Marshal::StringToHGlobalUni(html))
-        .ToPointer();
-    std::wstring htmlString = chars;
-
-    System::Runtime::InteropServices::Marshal::FreeHGlobal(System::IntPtr((void *)chars));
-
-    return htmlString;
-}
-
-
-std::wstring Spider::GetDecodedHtml(const std::wstring& html)
-{
-    System::String ^ decoded = Utilities::Utilities::GetDecodedHtml(gcnew System::String(html.c_str()));
-    const wchar_t* chars = (const wchar_t *)(System::Runtime::InteropServices::Marshal::StringToHGlobalUni(decoded))
-        .ToPointer();
-    std::wstring decodedString = chars;
-
-    System::Runtime::InteropServices::Marshal::FreeHGlobal(System::IntPtr((void *)chars));
-
-    return decodedString;
+    System::String ^ charset;
+    array<System::Byte> ^ data = Utilities::Utilities::DownloadHtml(gcnew System::String(url.c_str()), charset);
+    if (data->Length == 0)
+    {
+        return std::wstring();
+    }
+
+    // The bytes are decoded natively, in the charset of Content-Type if there is one, otherwise sniffed.
+    pin_ptr<System::Byte> pinned = &data[0];
+    const auto bytes = reinterpret_cast<const char*>(pinned);
+
+    std::string label;
+    if (charset != nullptr)
+    {
+        for (auto i = 0; i < charset->Length; i++)
+        {
+            label.push_back(static_cast<char>(charset[i]));
+        }
+    }
+
+    auto encoding = Transcoder::Encoding::Utf8;
+    if (Transcoder::GetEncoding(label.c_str(), static_cast<int>(label.size()), encoding))
+    {
+        return Transcoder::Decode(bytes, data->Length, encoding);
+    }
+
+    return Transcoder::DecodeHtml(bytes, data->Length);
 }
 
 void Spider::GenerateWordCloud(const std::wstring& csvFilePath, const std::wstring& savingFilePath)
@@ -6,11 +6,15 @@
 #define DATASTRUCTUREPROJECT_STACK_HPP
 
 #include <stdexcept>
+#include <functional>
+#include <type_traits>
+#include "NodeAllocator.hpp"
 
 
 /// \brief A stack class.
 /// \tparam TElement The type of the element in the list.
-template <typename TElement>
+/// \tparam TAllocator The allocator of the nodes, <code>HeapNodeAllocator</code> or <code>ArenaNodeAllocator</code>.
+template <typename TElement, template <typename> class TAllocator = HeapNodeAllocator>
 class Stack
 {
 public:
@@ -52,27 +56,29 @@ private:
 
     /// \brief Cached size.
     int _size = 0;
+
+    TAllocator<StackNode> _allocator;
 };
 
 
-template <typename TElement>
-Stack<TElement>::StackNode::StackNode(const TElement& element)
+template <typename TElement, template <typename> class TAllocator>
+Stack<TElement, TAllocator>::StackNode::StackNode(const TElement& element)
     : Element(element)
 {
 }
 
 
-template <typename TElement>
-void Stack<TElement>::Push(const TElement& element)
+template <typename TElement, template <typename> class TAllocator>
+void Stack<TElement, TAllocator>::Push(const TElement& element)
 {
     if (_topNode == nullptr)
     {
-        _topNode = new StackNode(element);
+        _topNode = _allocator.Create(element);
     }
     else
     {
         auto next = _topNode;
-        _topNode = new StackNode(element);
+        _topNode = _allocator.Create(element);
         _topNode->Next = next;
     }
 
@@ -80,23 +86,23 @@ void Stack<TElement>::Push(const TElement& element)
 }
 
 
-template <typename TElement>
-void Stack<TElement>::Pop()
+template <typename TElement, template <typename> class TAllocator>
+void Stack<TElement, TAllocator>::Pop()
 {
     if (_topNode == nullptr)
     {
         throw std::underflow_error("Stack underflow in Stack::Pop()");
     }
     auto next = _topNode->Next;
-    delete _topNode;
+    _allocator.Destroy(_topNode);
     _topNode = next;
 
     _size--;
 }
 
 
-template <typename TElement>
-TElement Stack<TElement>::Top()
+template <typename TElement, template <typename> class TAllocator>
+TElement Stack<TElement, TAllocator>::Top()
 {
     if (_topNode == nullptr)
     {
@@ -106,14 +112,14 @@ TElement Stack<TElement>::Top()
 }
 
 
-template <typename TElement>
-bool Stack<TElement>::IsEmpty()
+template <typename TElement, template <typename> class TAllocator>
+bool Stack<TElement, TAllocator>::IsEmpty()
 {
     return _topNode == nullptr;
 }
 
-template<typename TElement>
-inline bool Stack<TElement>::Contains(const TElement & element)
+template <typename TElement, template <typename> class TAllocator>
+inline bool Stack<TElement, TAllocator>::Contains(const TElement & element)
 {
     auto walker = _topNode;
     while (walker != nullptr)
@@ -131,8 +137,8 @@ inline bool Stack<TElement>::Contains(const TElement & element)
     return false;
 }
 
-template<typename TElement>
-inline bool Stack<TElement>::Contains(const std::function<bool(const TElement&element)>& prediction)
+template <typename TElement, template <typename> class TAllocator>
+inline bool Stack<TElement, TAllocator>::Contains(const std::function<bool(const TElement&element)>& prediction)
 {
     auto walker = _topNode;
     while (walker != nullptr)
@@ -151,13 +157,18 @@ inline bool Stack<TElement>::Contains(const std::function<bool(const TElement&el
 }
 
 
-template <typename TElement>
-Stack<TElement>::~Stack()
+template <typename TElement, template <typename> class TAllocator>
+Stack<TElement, TAllocator>::~Stack()
 {
+    if (TAllocator<StackNode>::ReleasesAll && std::is_trivially_destructible<TElement>::value)
+    {
+        return;
+    }
+
     while (_topNode != nullptr)
     {
         auto next = _topNode->Next;
-        delete _topNode;
+        _allocator.Destroy(_topNode);
         _topNode = next;
     }
 }
@@ -1,50 +1,64 @@
 #pragma once
 #include "CharString.hpp"
-#include "LinkedList.hpp"
-#include "Spider.hpp"
+#include "TermTable.hpp"
+#include <cstdint>
 #include <fstream>
+#include <vector>
+
+#ifdef _MANAGED
+#include "Spider.hpp"
+#endif
 
-// This class is slow but I'm too lazy to optimize it.
 class Statistics
 {
 public:
-    void AddWord(const CharString& word);
+    /// \brief Count a word.
+    /// \param termId Term id of the word in <code>TermTable::GetGlobal()</code>.
+    void AddWord(std::uint32_t termId);
     void GenerateCsvFile(const CharString& filePath);
+#ifdef _MANAGED
     void GenerateWordCloud(const CharString& csvFilePath, const CharString& picturePath);
+#endif
 private:
-    LinkedList<CharString> _words;
-    LinkedList<int> _freqs;
+    /// \brief The times each word occurs, indexed by term id.
+    std::vector<int> _freqs;
 };
 
-void Statistics::AddWord(const CharString& word)
+void Statistics::AddWord(const std::uint32_t termId)
 {
-    auto index = _words.IndexOf(word);
-    if (index != -1)
-    {
-        _freqs[index]++;
-    }
-    else
+    if (termId >= _freqs.size())
     {
-        _words.InsertAt(word, 0);
-        _freqs.InsertAt(1, 0);
+        _freqs.resize(termId + 1, 0);
     }
+
+    _freqs[termId]++;
 }
 
 void Statistics::GenerateCsvFile(const CharString& filePath)
 {
-    std::wfstream out;
-    out.imbue(std::locale("chs"));
-    out.open(filePath.ToStdWstring(), std::ios::trunc | std::ios::out);
-
-    for (auto i = 0; i < _words.GetLength(); i++)
+    // The file is in UTF-8, so it is written the same way everywhere.
+    const auto& terms = TermTable::GetGlobal();
+    std::string content;
+    for (std::uint32_t termId = 0; termId < _freqs.size(); termId++)
     {
-        out << _words.GetItemAt(i).ToStdWstring() << L"," << _freqs.GetItemAt(i) << L"\n";
+        if (_freqs[termId] == 0)
+        {
+            continue;
+        }
+
+        const auto& word = terms.GetWord(termId);
+        content.append(word.GetData(), word.GetByteLength());
+        content += "," + std::to_string(_freqs[termId]) + "\n";
     }
 
+    std::ofstream out(filePath.ToStdWstring(), std::ios::trunc | std::ios::binary);
+    out.write(content.data(), content.size());
     out.close();
 }
 
+#ifdef _MANAGED
 void Statistics::GenerateWordCloud(const CharString& csvFilePath, const CharString& picturePath)
 {
     Spider::GenerateWordCloud(csvFilePath.ToStdWstring(), picturePath.ToStdWstring());
 }
+#endif
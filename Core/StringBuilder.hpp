@@ -0,0 +1,171 @@
+//
+// Created on 2026/10/16 at 21:20.
+//
+
+#ifndef DATASTRUCTUREPROJECT_STRINGBUILDER_HPP
+#define DATASTRUCTUREPROJECT_STRINGBUILDER_HPP
+
+#include <algorithm>
+#include <stdexcept>
+#include "CharString.hpp"
+#include "CharStringView.hpp"
+
+
+/// \brief Joins characters into a <code>CharString</code>.
+/// \note The capacity at least doubles when it runs out, so appending n characters copies O(n) characters.
+/// The buffer is handed over to the <code>CharString</code> when finished, nothing is copied again.
+class StringBuilder
+{
+public:
+    StringBuilder() = default;
+
+    /// \param capacity The number of characters to allocate room for.
+    explicit StringBuilder(int capacity);
+
+    StringBuilder(const StringBuilder&) = delete;
+    StringBuilder& operator=(const StringBuilder&) = delete;
+
+    ~StringBuilder();
+
+    /// \brief Append some characters.
+    /// \param view The characters to append, they must not be in the builder.
+    void Append(const CharStringView& view);
+
+    /// \brief Append a character.
+    void Append(wchar_t character);
+
+    /// \brief Append room for some characters, to be written through the returned pointer.
+    /// \param count The number of characters.
+    /// \return Pointer to the first of them, invalidated when the builder grows.
+    /// \note Use <code>Truncate</code> if fewer characters are written.
+    wchar_t* Expand(int count);
+
+    /// \brief Drop the characters after a length.
+    /// \param length The new length, no more than the current one.
+    /// \throw std::out_of_range if the length is invalid.
+    void Truncate(int length);
+
+    /// \brief Make sure some characters fit without growing.
+    /// \param capacity The number of characters.
+    void Reserve(int capacity);
+
+    /// \brief Get the characters appended so far, invalidated when the builder grows.
+    wchar_t* GetData();
+
+    int GetLength() const;
+
+    /// \brief View the characters appended so far, invalidated when the builder is modified.
+    CharStringView GetView() const;
+
+    /// \brief Finish building.
+    /// \return The string of the appended characters.
+    /// \note The buffer is handed over to the string and the builder is left empty.
+    CharString ToCharString();
+
+private:
+    wchar_t* _data = nullptr;
+    int _length = 0;
+    int _capacity = 0;
+
+    /// \brief The capacity of the first buffer.
+    static const int InitialCapacity = 32;
+};
+
+
+inline StringBuilder::StringBuilder(const int capacity)
+{
+    Reserve(capacity);
+}
+
+
+inline StringBuilder::~StringBuilder()
+{
+    delete[] _data;
+}
+
+
+inline void StringBuilder::Append(const CharStringView& view)
+{
+    std::copy_n(view.GetData(), view.GetLength(), Expand(view.GetLength()));
+}
+
+
+inline void StringBuilder::Append(const wchar_t character)
+{
+    *Expand(1) = character;
+}
+
+
+inline wchar_t* StringBuilder::Expand(const int count)
+{
+    if (_length + count > _capacity)
+    {
+        Reserve(std::max({_length + count, _capacity * 2, InitialCapacity}));
+    }
+
+    const auto expanded = _data + _length;
+    _length += count;
+
+    return expanded;
+}
+
+
+inline void StringBuilder::Truncate(const int length)
+{
+    if (length < 0 || length > _length)
+    {
+        throw std::out_of_range("Length out of range in StringBuilder::Truncate()");
+    }
+
+    _length = length;
+}
+
+
+inline void StringBuilder::Reserve(const int capacity)
+{
+    if (capacity <= _capacity)
+    {
+        return;
+    }
+
+    const auto newData = new wchar_t[capacity];
+    std::copy_n(_data, _length, newData);
+    delete[] _data;
+
+    _data = newData;
+    _capacity = capacity;
+}
+
+
+inline wchar_t* StringBuilder::GetData()
+{
+    return _data;
+}
+
+
+inline int StringBuilder::GetLength() const
+{
+    return _length;
+}
+
+
+inline CharStringView StringBuilder::GetView() const
+{
+    return CharStringView(_data, _length);
+}
+
+
+inline CharString StringBuilder::ToCharString()
+{
+    CharString ret;
+    ret.Adopt(_data, _length);
+
+    _data = nullptr;
+    _length = 0;
+    _capacity = 0;
+
+    return ret;
+}
+
+
+#endif //DATASTRUCTUREPROJECT_STRINGBUILDER_HPP
@@ -0,0 +1,245 @@
+//
+// Created on 2026/10/16 at 20:35.
+//
+
+#ifndef DATASTRUCTUREPROJECT_TERMTABLE_HPP
+#define DATASTRUCTUREPROJECT_TERMTABLE_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <omp.h>
+#include "CharStringView.hpp"
+#include "Utf8String.hpp"
+#include "FlatHashMap.hpp"
+
+
+/// \brief Interns words, each distinct word gets a dense term id starting from 0, in the order they are first met.
+/// \note The words are split into shards by their hash codes, each shard has its own lock,
+/// so the threads splitting different documents rarely wait for each other.
+/// The words are kept only in blocks indexed by term id, the shards hold the term ids and look their words up
+/// in the blocks. The blocks are never moved, so <code>GetWord</code> can be called while other threads are interning.
+class TermTable
+{
+public:
+    /// \brief Get the term id of a word, the word is added if it is not in the table.
+    /// \param word The word.
+    /// \return The term id of the word.
+    /// \throw std::length_error if the table is full.
+    /// \note It can be called by several threads at once.
+    std::uint32_t Intern(const CharStringView& word);
+
+    /// \brief Get the term id of a word without adding it.
+    /// \param word The word.
+    /// \param termId Set to the term id if the word is in the table.
+    /// \return True if the word is in the table, otherwise false.
+    /// \note It can be called by several threads at once.
+    bool Find(const CharStringView& word, std::uint32_t& termId) const;
+
+    /// \brief Get the word of a term id.
+    /// \param termId A term id returned by <code>Intern</code> or <code>Find</code>.
+    /// \return The word in UTF-8.
+    const Utf8String& GetWord(std::uint32_t termId) const;
+
+    /// \brief Get the number of words in the table.
+    /// \return The number of words, the term ids are in [0, count).
+    /// \note Do not call it while interning.
+    int GetCount() const;
+
+    /// \brief Get the table shared by the whole program, the words of all the documents and queries are interned in it.
+    /// \return The global table.
+    static TermTable& GetGlobal();
+
+    static const int ShardCount = 64;
+    static const int BlockSize = 4096;
+    static const int MaxBlockCount = 16384;
+
+    TermTable();
+    TermTable(const TermTable& rhs) = delete;
+    TermTable& operator=(const TermTable& rhs) = delete;
+    ~TermTable();
+
+    class Hasher
+    {
+    public:
+        int operator()(const std::uint32_t termId) const
+        {
+            return static_cast<int>(termId);
+        }
+    };
+
+private:
+    /// \brief A word looked up in a shard, it equals the term ids whose words are the same.
+    class WordLookup
+    {
+    public:
+        const TermTable* Table;
+        CharStringView Word;
+
+        friend bool operator==(const std::uint32_t termId, const WordLookup& lookup)
+        {
+            return lookup.Table->GetWord(termId) == lookup.Word;
+        }
+    };
+
+    /// \brief Hashes a term id by its word in the blocks, and a looked up word by itself.
+    class WordHasher
+    {
+    public:
+        const TermTable* Table = nullptr;
+
+        std::uint64_t operator()(const std::uint32_t termId) const
+        {
+            return Table->GetWord(termId).GetHashCode();
+        }
+
+        std::uint64_t operator()(const WordLookup& lookup) const
+        {
+            return lookup.Word.GetHashCode();
+        }
+    };
+
+    class Shard
+    {
+    public:
+        /// \brief The term ids of the words in the shard, each maps to itself.
+        FlatHashMap<std::uint32_t, std::uint32_t, WordHasher> TermIds;
+        omp_lock_t Lock;
+    };
+
+    /// \brief The shards, <code>ShardCount</code> of them.
+    Shard* _shards = nullptr;
+
+    /// \brief Pointers to the blocks of words, <code>MaxBlockCount</code> of them, allocated when first used.
+    Utf8String** _blocks = nullptr;
+
+    int _count = 0;
+
+    /// \brief Guards <code>_count</code> and <code>_blocks</code>.
+    omp_lock_t _appendLock;
+
+    /// \brief Get the shard a hash code falls in.
+    /// \note The high bits are used, the maps in the shards start from the low bits.
+    static int GetShardIndex(std::uint64_t hashCode);
+};
+
+
+inline std::uint32_t TermTable::Intern(const CharStringView& word)
+{
+    auto& shard = _shards[GetShardIndex(word.GetHashCode())];
+    omp_set_lock(&shard.Lock);
+
+    auto location = shard.TermIds.Locate(WordLookup{this, word});
+    if (location != shard.TermIds.EmptyIterator())
+    {
+        const auto termId = *location;
+        omp_unset_lock(&shard.Lock);
+        return termId;
+    }
+
+    // Only the new words take the global lock.
+    omp_set_lock(&_appendLock);
+
+    const auto termId = static_cast<std::uint32_t>(_count);
+    const auto isFull = _count == MaxBlockCount * BlockSize;
+    if (!isFull)
+    {
+        auto& block = _blocks[_count / BlockSize];
+        if (block == nullptr)
+        {
+            block = new Utf8String[BlockSize];
+        }
+
+        block[_count % BlockSize].Assign(word);
+        _count++;
+    }
+
+    omp_unset_lock(&_appendLock);
+
+    if (isFull)
+    {
+        omp_unset_lock(&shard.Lock);
+        throw std::length_error("Too many words in TermTable::Intern()");
+    }
+
+    shard.TermIds.Insert(termId, termId);
+    omp_unset_lock(&shard.Lock);
+
+    return termId;
+}
+
+
+inline bool TermTable::Find(const CharStringView& word, std::uint32_t& termId) const
+{
+    auto& shard = _shards[GetShardIndex(word.GetHashCode())];
+    omp_set_lock(&shard.Lock);
+
+    auto location = shard.TermIds.Locate(WordLookup{this, word});
+    const auto isFound = location != shard.TermIds.EmptyIterator();
+    if (isFound)
+    {
+        termId = *location;
+    }
+
+    omp_unset_lock(&shard.Lock);
+    return isFound;
+}
+
+
+inline const Utf8String& TermTable::GetWord(const std::uint32_t termId) const
+{
+    return _blocks[termId / BlockSize][termId % BlockSize];
+}
+
+
+inline int TermTable::GetCount() const
+{
+    return _count;
+}
+
+
+inline TermTable& TermTable::GetGlobal()
+{
+    static TermTable table;
+    return table;
+}
+
+
+inline TermTable::TermTable()
+{
+    _shards = new Shard[ShardCount];
+    for (auto i = 0; i < ShardCount; i++)
+    {
+        _shards[i].TermIds = FlatHashMap<std::uint32_t, std::uint32_t, WordHasher>(WordHasher{this});
+        omp_init_lock(&_shards[i].Lock);
+    }
+
+    _blocks = new Utf8String*[MaxBlockCount]();
+    omp_init_lock(&_appendLock);
+}
+
+
+inline TermTable::~TermTable()
+{
+    for (auto i = 0; i < ShardCount; i++)
+    {
+        omp_destroy_lock(&_shards[i].Lock);
+    }
+    delete[] _shards;
+
+    for (auto i = 0; i < MaxBlockCount; i++)
+    {
+        delete[] _blocks[i];
+    }
+    delete[] _blocks;
+
+    omp_destroy_lock(&_appendLock);
+}
+
+
+inline int TermTable::GetShardIndex(const std::uint64_t hashCode)
+{
+    return static_cast<int>((hashCode >> 32) % ShardCount);
+}
+
+
+#endif //DATASTRUCTUREPROJECT_TERMTABLE_HPP
@@ -0,0 +1,259 @@
+//
+// Created on 2026/10/16 at 11:45.
+//
+
+#ifndef DATASTRUCTUREPROJECT_TOPKQUERYENGINE_HPP
+#define DATASTRUCTUREPROJECT_TOPKQUERYENGINE_HPP
+
+#include <cmath>
+#include <queue>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "LinkedList.hpp"
+#include "PostingList.hpp"
+
+
+/// \brief A cursor walking the postings of one query term.
+class TermCursor
+{
+public:
+    PostingList::Iterator Current;
+    PostingList::Iterator End;
+
+    /// \brief Number of documents containing the term.
+    int DocumentFrequency = 0;
+
+    /// \brief Maximum frequency of the term in a single document.
+    int MaxFrequency = 0;
+
+    /// \brief Inverse document frequency, filled by the engine.
+    double Idf = 0;
+
+    /// \brief Upper bound of the score the term can contribute to a document, filled by the engine.
+    double UpperBound = 0;
+
+    TermCursor(const PostingList::Iterator& begin, const PostingList::Iterator& end, int documentFrequency,
+               int maxFrequency)
+        : Current(begin), End(end), DocumentFrequency(documentFrequency), MaxFrequency(maxFrequency)
+    {
+    }
+
+    explicit TermCursor(const PostingList& postingList)
+        : TermCursor(postingList.begin(), postingList.end(), postingList.GetLength(), postingList.GetMaxFrequency())
+    {
+    }
+
+    /// \brief Test if all the postings have been visited.
+    bool IsEnd() const
+    {
+        return Current == End;
+    }
+
+    /// \brief Move to the first posting whose document id is not less than the given one.
+    /// \param documentId The target document id.
+    void SkipTo(int documentId)
+    {
+        while (Current != End && Current->DocumentId < documentId)
+        {
+            ++Current;
+        }
+    }
+};
+
+
+/// \brief Ranked retrieval with BM25 scoring, returning only the best k documents.
+/// \note Uses MaxScore pruning: terms are ordered by their score upper bounds,
+/// and the terms whose bounds together cannot beat the current k-th score are only probed,
+/// never used to generate candidates.
+class TopKQueryEngine
+{
+public:
+    /// \brief The BM25 term frequency saturation parameter.
+    static constexpr double K1 = 1.2;
+
+    /// \brief The BM25 length normalization parameter.
+    static constexpr double B = 0.75;
+
+    /// \brief Get the best k documents for the query.
+    /// \tparam TDocumentStatistics Type providing <code>GetLength(id)</code>, <code>GetDocumentCount()</code>,
+    /// <code>GetAverageLength()</code> and <code>GetMinimumLength()</code>.
+    /// \param cursors Cursors of the distinct query terms found in the index, they will be consumed.
+    /// \param statistics Statistics of the indexed documents.
+    /// \param k The number of documents to return.
+    /// \return Pairs of document id and score, in descending order of score.
+    /// Documents with the same score are in ascending order of id.
+    template <typename TDocumentStatistics>
+    static LinkedList<std::pair<int, double>> Query(std::vector<TermCursor>& cursors,
+                                                    const TDocumentStatistics& statistics, int k);
+
+    /// \brief Get the inverse document frequency of a term.
+    /// \param documentCount Number of documents in the collection.
+    /// \param documentFrequency Number of documents containing the term.
+    /// \return The inverse document frequency, always positive.
+    static double GetIdf(int documentCount, int documentFrequency);
+
+    /// \brief Get the BM25 score of a term in a document.
+    /// \param idf Inverse document frequency of the term.
+    /// \param frequency The times the term occurs in the document.
+    /// \param length Length of the document.
+    /// \param averageLength Average length of the documents.
+    /// \return The score.
+    static double GetScore(double idf, int frequency, int length, double averageLength);
+
+private:
+    class ScoredDocument
+    {
+    public:
+        double Score;
+        int DocumentId;
+
+        /// \brief Order used by the heap, the top of the heap is the worst document kept.
+        bool operator>(const ScoredDocument& rhs) const
+        {
+            return Score > rhs.Score || (Score == rhs.Score && DocumentId < rhs.DocumentId);
+        }
+    };
+};
+
+
+template <typename TDocumentStatistics>
+LinkedList<std::pair<int, double>> TopKQueryEngine::Query(std::vector<TermCursor>& cursors,
+                                                          const TDocumentStatistics& statistics, const int k)
+{
+    LinkedList<std::pair<int, double>> ret;
+    const auto documentCount = statistics.GetDocumentCount();
+
+    if (k <= 0 || cursors.empty() || documentCount == 0)
+    {
+        return ret;
+    }
+
+    const auto averageLength = statistics.GetAverageLength();
+    const auto minimumLength = statistics.GetMinimumLength();
+
+    for (auto& cursor : cursors)
+    {
+        cursor.Idf = GetIdf(documentCount, cursor.DocumentFrequency);
+
+        // The score grows with the frequency and drops with the length.
+        cursor.UpperBound = GetScore(cursor.Idf, cursor.MaxFrequency, minimumLength, averageLength);
+    }
+
+    std::sort(cursors.begin(), cursors.end(), [](const TermCursor& lhs, const TermCursor& rhs)-> bool
+    {
+        return lhs.UpperBound < rhs.UpperBound;
+    });
+
+    const auto termCount = static_cast<int>(cursors.size());
+
+    // boundSums[i] is the sum of the upper bounds of cursors[0..i].
+    std::vector<double> boundSums(termCount);
+    auto boundSum = 0.0;
+    for (auto i = 0; i < termCount; i++)
+    {
+        boundSum += cursors[i].UpperBound;
+        boundSums[i] = boundSum;
+    }
+
+    std::priority_queue<ScoredDocument, std::vector<ScoredDocument>, std::greater<ScoredDocument>> heap;
+    auto threshold = 0.0;
+
+    // Cursors before firstEssential can not make a document enter the heap by themselves.
+    auto firstEssential = 0;
+
+    while (firstEssential < termCount)
+    {
+        auto candidate = -1;
+        for (auto i = firstEssential; i < termCount; i++)
+        {
+            if (!cursors[i].IsEnd() && (candidate == -1 || cursors[i].Current->DocumentId < candidate))
+            {
+                candidate = cursors[i].Current->DocumentId;
+            }
+        }
+
+        if (candidate == -1)
+        {
+            break;
+        }
+
+        const auto length = statistics.GetLength(candidate);
+        auto score = 0.0;
+
+        for (auto i = firstEssential; i < termCount; i++)
+        {
+            auto& cursor = cursors[i];
+            if (!cursor.IsEnd() && cursor.Current->DocumentId == candidate)
+            {
+                score += GetScore(cursor.Idf, cursor.Current->Frequency, length, averageLength);
+                ++cursor.Current;
+            }
+        }
+
+        for (auto i = firstEssential - 1; i >= 0; i--)
+        {
+            if (score + boundSums[i] <= threshold)
+            {
+                break;
+            }
+
+            auto& cursor = cursors[i];
+            cursor.SkipTo(candidate);
+            if (!cursor.IsEnd() && cursor.Current->DocumentId == candidate)
+            {
+                score += GetScore(cursor.Idf, cursor.Current->Frequency, length, averageLength);
+            }
+        }
+
+        // Candidates come in ascending order of id, a tie never beats a document already kept.
+        if (static_cast<int>(heap.size()) < k)
+        {
+            heap.push(ScoredDocument{score, candidate});
+        }
+        else if (score > threshold)
+        {
+            heap.pop();
+            heap.push(ScoredDocument{score, candidate});
+        }
+        else
+        {
+            continue;
+        }
+
+        if (static_cast<int>(heap.size()) == k)
+        {
+            threshold = heap.top().Score;
+            while (firstEssential < termCount && boundSums[firstEssential] <= threshold)
+            {
+                firstEssential++;
+            }
+        }
+    }
+
+    // The heap pops the worst document first.
+    while (!heap.empty())
+    {
+        ret.InsertAt(std::make_pair(heap.top().DocumentId, heap.top().Score), 0);
+        heap.pop();
+    }
+
+    return ret;
+}
+
+
+inline double TopKQueryEngine::GetIdf(const int documentCount, const int documentFrequency)
+{
+    return std::log(1 + (documentCount - documentFrequency + 0.5) / (documentFrequency + 0.5));
+}
+
+
+inline double TopKQueryEngine::GetScore(const double idf, const int frequency, const int length,
+                                        const double averageLength)
+{
+    const auto normalization = 1 - B + B * length / averageLength;
+    return idf * frequency * (K1 + 1) / (frequency + K1 * normalization);
+}
+
+
+#endif //DATASTRUCTUREPROJECT_TOPKQUERYENGINE_HPP
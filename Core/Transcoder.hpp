@@ -0,0 +1,370 @@
+//
+// Created on 2026/10/16 at 19:45.
+//
+
+#ifndef DATASTRUCTUREPROJECT_TRANSCODER_HPP
+#define DATASTRUCTUREPROJECT_TRANSCODER_HPP
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "Utf8.hpp"
+#include "Simd.hpp"
+#include "MappedFile.hpp"
+#include "Gb18030Table.hpp"
+
+
+/// \brief Decodes the bytes of pages and text files to wide strings, without any locale.
+/// \note UTF-8 and GB18030 are supported, GBK and GB2312 are decoded as GB18030, which is a superset of them.
+/// Invalid sequences are decoded as U+FFFD.
+class Transcoder
+{
+public:
+    enum class Encoding
+    {
+        Utf8,
+        Gb18030
+    };
+
+    /// \brief Get the encoding named by a label, e.g. the charset in <code>Content-Type</code>.
+    /// \param label Pointer to the label, case-insensitive.
+    /// \param length Length of the label.
+    /// \param encoding Set to the encoding if the label is known.
+    /// \return True if the label is known, otherwise false.
+    static bool GetEncoding(const char* label, int length, Encoding& encoding);
+
+    /// \brief Guess the encoding of a HTML file from its byte order mark or its <code>&lt;meta&gt;</code> charset.
+    /// \param data Pointer to the first byte.
+    /// \param length The number of bytes.
+    /// \param fallback The encoding used if none is found.
+    /// \return The encoding.
+    /// \note Only the first <code>SniffingLength</code> bytes are looked at.
+    static Encoding Sniff(const char* data, int length, Encoding fallback);
+
+    /// \brief Decode some bytes and append them to a wide string.
+    /// \param data Pointer to the first byte.
+    /// \param length The number of bytes.
+    /// \param encoding The encoding of the bytes.
+    /// \param wstring The wide string to append to.
+    /// \note If the bytes start with the UTF-8 byte order mark, it is skipped and the rest is decoded as UTF-8.
+    /// The runs of ASCII are widened 16 bytes at a time.
+    static void Decode(const char* data, int length, Encoding encoding, std::wstring& wstring);
+
+    /// \brief Decode some bytes to a wide string.
+    /// \param data Pointer to the first byte.
+    /// \param length The number of bytes.
+    /// \param encoding The encoding of the bytes.
+    /// \return The decoded string.
+    static std::wstring Decode(const char* data, int length, Encoding encoding);
+
+    /// \brief Decode a HTML file in the encoding guessed by <code>Sniff</code>, UTF-8 if none is found.
+    /// \param data Pointer to the first byte.
+    /// \param length The number of bytes.
+    /// \return The decoded file.
+    static std::wstring DecodeHtml(const char* data, int length);
+
+    /// \brief Read the lines of a text file, like <code>getline</code> does.
+    /// \param filePath Path to the file.
+    /// \param encoding The encoding of the file, UTF-8 is used instead if the file starts with its byte order mark.
+    /// \return The lines without the line breaks, empty if the file can not be read.
+    static std::vector<std::wstring> ReadLines(const std::string& filePath, Encoding encoding);
+
+    static const int SniffingLength = 1024;
+
+private:
+    /// \brief Decode GB18030 bytes into a buffer with room for <code>length</code> characters.
+    /// \return The number of characters written.
+    static int DecodeGb18030(const unsigned char* data, int length, wchar_t* output);
+
+    /// \brief Get the code point of a four-byte GB18030 sequence.
+    /// \param pointer The pointer of the sequence, see <code>Gb18030Table::GetRanges</code>.
+    /// \return The code point, U+FFFD if the sequence is not mapped.
+    static unsigned int GetFourByteCodePoint(unsigned int pointer);
+
+    /// \brief Test if some bytes start with a string, case-insensitive.
+    /// \param lowercase The string in lowercase.
+    static bool StartsWith(const char* data, const char* end, const char* lowercase);
+};
+
+
+inline bool Transcoder::GetEncoding(const char* label, const int length, Encoding& encoding)
+{
+    // The labels of the encoding standard of WHATWG.
+    static const char* utf8Labels[] = {"utf-8", "utf8", "unicode-1-1-utf-8"};
+    static const char* gb18030Labels[] = {
+        "gb18030", "gbk", "gb2312", "gb_2312", "gb_2312-80", "x-gbk", "chinese", "csgb2312", "csiso58gb231280",
+        "iso-ir-58"
+    };
+
+    const auto end = label + length;
+    for (const auto utf8Label : utf8Labels)
+    {
+        if (static_cast<int>(std::strlen(utf8Label)) == length && StartsWith(label, end, utf8Label))
+        {
+            encoding = Encoding::Utf8;
+            return true;
+        }
+    }
+
+    for (const auto gb18030Label : gb18030Labels)
+    {
+        if (static_cast<int>(std::strlen(gb18030Label)) == length && StartsWith(label, end, gb18030Label))
+        {
+            encoding = Encoding::Gb18030;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+inline Transcoder::Encoding Transcoder::Sniff(const char* data, const int length, const Encoding fallback)
+{
+    if (StartsWith(data, data + length, "\xEF\xBB\xBF"))
+    {
+        return Encoding::Utf8;
+    }
+
+    // Look for the charset in the meta tags, both <meta charset="gbk"> and
+    // <meta http-equiv="Content-Type" content="text/html; charset=gbk"> are written this way.
+    const auto end = data + std::min(length, static_cast<int>(SniffingLength));
+    for (auto reading = data; reading < end; reading++)
+    {
+        if (*reading != '<' || !StartsWith(reading, end, "<meta"))
+        {
+            continue;
+        }
+
+        const auto tagEnd = std::find(reading, end, '>');
+        for (auto charset = reading; charset < tagEnd; charset++)
+        {
+            if (!StartsWith(charset, tagEnd, "charset"))
+            {
+                continue;
+            }
+
+            auto label = charset + 7;
+            while (label < tagEnd && (*label == ' ' || *label == '='))
+            {
+                label++;
+            }
+            while (label < tagEnd && (*label == '"' || *label == '\''))
+            {
+                label++;
+            }
+
+            auto labelEnd = label;
+            while (labelEnd < tagEnd && *labelEnd != '"' && *labelEnd != '\'' && *labelEnd != ';' &&
+                *labelEnd != ' ' && *labelEnd != '/')
+            {
+                labelEnd++;
+            }
+
+            auto encoding = fallback;
+            if (GetEncoding(label, static_cast<int>(labelEnd - label), encoding))
+            {
+                return encoding;
+            }
+        }
+
+        reading = tagEnd;
+    }
+
+    return fallback;
+}
+
+
+inline void Transcoder::Decode(const char* data, int length, Encoding encoding, std::wstring& wstring)
+{
+    if (StartsWith(data, data + length, "\xEF\xBB\xBF"))
+    {
+        data += 3;
+        length -= 3;
+        encoding = Encoding::Utf8;
+    }
+
+    if (encoding == Encoding::Utf8)
+    {
+        Utf8::Decode(data, length, wstring);
+        return;
+    }
+
+    if (length == 0)
+    {
+        return;
+    }
+
+    // A sequence never decodes to more characters than bytes, so decode straight into the string and shrink it.
+    const auto start = wstring.size();
+    wstring.resize(start + length);
+    const auto written = DecodeGb18030(reinterpret_cast<const unsigned char*>(data), length, &wstring[start]);
+    wstring.resize(start + written);
+}
+
+
+inline std::wstring Transcoder::Decode(const char* data, const int length, const Encoding encoding)
+{
+    std::wstring ret;
+    Decode(data, length, encoding, ret);
+    return ret;
+}
+
+
+inline std::wstring Transcoder::DecodeHtml(const char* data, const int length)
+{
+    return Decode(data, length, Sniff(data, length, Encoding::Utf8));
+}
+
+
+inline std::vector<std::wstring> Transcoder::ReadLines(const std::string& filePath, const Encoding encoding)
+{
+    std::vector<std::wstring> lines;
+    std::wstring content;
+
+    try
+    {
+        const MappedFile file(filePath);
+        const auto data = reinterpret_cast<const char*>(file.GetData());
+        const auto size = static_cast<int>(file.GetSize());
+        Decode(data, size, encoding, content);
+    }
+    catch (const std::runtime_error&)
+    {
+        return lines;
+    }
+
+    std::wstring::size_type start = 0;
+    while (start < content.size())
+    {
+        auto lineEnd = content.find(L'\n', start);
+        if (lineEnd == std::wstring::npos)
+        {
+            lineEnd = content.size();
+        }
+
+        // The files are written on Windows, drop the carriage returns as the text mode does.
+        auto length = lineEnd - start;
+        if (length > 0 && content[lineEnd - 1] == L'\r')
+        {
+            length--;
+        }
+
+        lines.push_back(content.substr(start, length));
+        start = lineEnd + 1;
+    }
+
+    return lines;
+}
+
+
+inline int Transcoder::DecodeGb18030(const unsigned char* data, const int length, wchar_t* output)
+{
+    const auto twoByteTable = Gb18030Table::GetTwoByteTable();
+    auto reading = 0;
+    auto writing = 0;
+
+    while (reading < length)
+    {
+        const auto lead = data[reading];
+
+        if (lead < 0x80)
+        {
+            const auto widened = Simd::WidenAscii(data + reading, length - reading, output + writing);
+            reading += widened;
+            writing += widened;
+            continue;
+        }
+
+        auto codePoint = static_cast<unsigned int>(Utf8::ReplacementCharacter);
+        reading++;
+
+        if (lead == 0x80)
+        {
+            codePoint = 0x20AC;
+        }
+        else if (lead != 0xFF && reading < length)
+        {
+            const auto second = data[reading];
+
+            if (second >= 0x30 && second <= 0x39)
+            {
+                // A four-byte sequence.
+                if (reading + 2 < length && data[reading + 1] >= 0x81 && data[reading + 1] <= 0xFE &&
+                    data[reading + 2] >= 0x30 && data[reading + 2] <= 0x39)
+                {
+                    const auto pointer = (((lead - 0x81) * 10u + second - 0x30) * 126u + data[reading + 1] - 0x81) *
+                        10u + data[reading + 2] - 0x30;
+                    codePoint = GetFourByteCodePoint(pointer);
+                    reading += 3;
+                }
+            }
+            else if (second >= 0x40 && second <= 0xFE && second != 0x7F)
+            {
+                const auto index = (lead - 0x81) * Gb18030Table::TrailCount + second - (second < 0x7F ? 0x40 : 0x41);
+                codePoint = twoByteTable[index];
+                reading++;
+            }
+
+            // Otherwise the second byte starts the next sequence.
+        }
+
+        writing += Utf8::WriteCodePoint(codePoint, output + writing);
+    }
+
+    return writing;
+}
+
+
+inline unsigned int Transcoder::GetFourByteCodePoint(const unsigned int pointer)
+{
+    // The supplementary planes are mapped in order.
+    if (pointer >= 189000 && pointer <= 1237575)
+    {
+        return 0x10000 + pointer - 189000;
+    }
+
+    if (pointer > 39419)
+    {
+        return Utf8::ReplacementCharacter;
+    }
+
+    const auto ranges = Gb18030Table::GetRanges();
+    const auto range = std::upper_bound(ranges, ranges + Gb18030Table::RangeCount, pointer,
+                                        [](const unsigned int target, const Gb18030Table::Range& item)-> bool
+                                        {
+                                            return target < item.Pointer;
+                                        }) - 1;
+
+    return range->CodePoint + pointer - range->Pointer;
+}
+
+
+inline bool Transcoder::StartsWith(const char* data, const char* end, const char* lowercase)
+{
+    for (; *lowercase != '\0'; data++, lowercase++)
+    {
+        if (data == end)
+        {
+            return false;
+        }
+
+        auto character = *data;
+        if (character >= 'A' && character <= 'Z')
+        {
+            character = static_cast<char>(character - 'A' + 'a');
+        }
+
+        if (character != *lowercase)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+#endif //DATASTRUCTUREPROJECT_TRANSCODER_HPP
@@ -0,0 +1,321 @@
+//
+// Created on 2026/10/16 at 13:02.
+//
+
+#ifndef DATASTRUCTUREPROJECT_UTF8_HPP
+#define DATASTRUCTUREPROJECT_UTF8_HPP
+
+#include <string>
+#include "Simd.hpp"
+
+
+/// \brief A set of methods to convert between <code>wchar_t</code> strings and UTF-8.
+/// \note <code>wchar_t</code> strings are UTF-16 when <code>wchar_t</code> is 2 bytes (Windows),
+/// otherwise they are UTF-32.
+class Utf8
+{
+public:
+    /// \brief Encode wide characters to UTF-8 and append them to a buffer.
+    /// \param data Pointer to the first character.
+    /// \param length The number of characters.
+    /// \param buffer The buffer to append to.
+    /// \note Unpaired surrogates are encoded as U+FFFD.
+    static void Encode(const wchar_t* data, int length, std::string& buffer);
+
+    /// \brief Encode a wide string to UTF-8.
+    /// \param wstring The string to encode.
+    /// \return The encoded string.
+    static std::string Encode(const std::wstring& wstring);
+
+    /// \brief Encode wide characters to UTF-8 into a buffer.
+    /// \param data Pointer to the first character.
+    /// \param length The number of characters.
+    /// \param output Where to write the bytes, it must have room for <code>GetEncodedLength(data, length)</code> bytes.
+    /// \return The number of bytes written.
+    static int Encode(const wchar_t* data, int length, char* output);
+
+    /// \brief Get the number of bytes some wide characters take in UTF-8.
+    /// \param data Pointer to the first character.
+    /// \param length The number of characters.
+    /// \return The number of bytes.
+    static int GetEncodedLength(const wchar_t* data, int length);
+
+    /// \brief Decode UTF-8 bytes and append them to a wide string.
+    /// \param data Pointer to the first byte.
+    /// \param length The number of bytes.
+    /// \param wstring The wide string to append to.
+    /// \note Invalid sequences are decoded as U+FFFD. The runs of ASCII are widened 16 bytes at a time.
+    static void Decode(const char* data, int length, std::wstring& wstring);
+
+    /// \brief Decode UTF-8 bytes to a wide string.
+    /// \param data Pointer to the first byte.
+    /// \param length The number of bytes.
+    /// \return The decoded string.
+    static std::wstring Decode(const char* data, int length);
+
+    /// \brief Decode UTF-8 bytes into a buffer.
+    /// \param data Pointer to the first byte.
+    /// \param length The number of bytes.
+    /// \param output Where to write the characters, it must have room for <code>length</code> characters.
+    /// \return The number of characters written.
+    static int Decode(const char* data, int length, wchar_t* output);
+
+    /// \brief Decode one code point.
+    /// \param data Pointer to the first byte of the code point, will be moved past it.
+    /// \param end Pointer past the last byte of the buffer.
+    /// \return The code point, U+FFFD if the sequence is invalid.
+    static unsigned int DecodeCodePoint(const unsigned char*& data, const unsigned char* end);
+
+    /// \brief Append a code point as wide characters.
+    /// \param codePoint The code point.
+    /// \param wstring The wide string to append to.
+    static void AppendCodePoint(unsigned int codePoint, std::wstring& wstring);
+
+    /// \brief Write a code point as wide characters.
+    /// \param codePoint The code point.
+    /// \param output Where to write the characters, it must have room for 2 characters.
+    /// \return The number of characters written.
+    static int WriteCodePoint(unsigned int codePoint, wchar_t* output);
+
+    /// \brief Read one code point from wide characters.
+    /// \param data Pointer to the first character.
+    /// \param length The number of characters.
+    /// \param index Index of the character to read, moved to the last character of the code point.
+    /// \return The code point, U+FFFD if it is an unpaired surrogate or out of range.
+    static unsigned int ReadCodePoint(const wchar_t* data, int length, int& index);
+
+    static const unsigned int ReplacementCharacter = 0xFFFD;
+};
+
+
+inline void Utf8::Encode(const wchar_t* data, const int length, std::string& buffer)
+{
+    const auto start = buffer.size();
+    buffer.resize(start + GetEncodedLength(data, length));
+    if (buffer.size() > start)
+    {
+        Encode(data, length, &buffer[start]);
+    }
+}
+
+
+inline int Utf8::Encode(const wchar_t* data, const int length, char* output)
+{
+    auto writing = output;
+
+    for (auto i = 0; i < length; i++)
+    {
+        if (static_cast<unsigned int>(data[i]) < 0x80)
+        {
+            *writing++ = static_cast<char>(data[i]);
+            continue;
+        }
+
+        const auto codePoint = ReadCodePoint(data, length, i);
+
+        if (codePoint < 0x800)
+        {
+            *writing++ = static_cast<char>(0xC0 | (codePoint >> 6));
+            *writing++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint < 0x10000)
+        {
+            *writing++ = static_cast<char>(0xE0 | (codePoint >> 12));
+            *writing++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            *writing++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else
+        {
+            *writing++ = static_cast<char>(0xF0 | (codePoint >> 18));
+            *writing++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            *writing++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            *writing++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    return static_cast<int>(writing - output);
+}
+
+
+inline int Utf8::GetEncodedLength(const wchar_t* data, const int length)
+{
+    auto encodedLength = 0;
+
+    for (auto i = 0; i < length; i++)
+    {
+        if (static_cast<unsigned int>(data[i]) < 0x80)
+        {
+            encodedLength++;
+            continue;
+        }
+
+        const auto codePoint = ReadCodePoint(data, length, i);
+        encodedLength += codePoint < 0x800 ? 2 : codePoint < 0x10000 ? 3 : 4;
+    }
+
+    return encodedLength;
+}
+
+
+inline std::string Utf8::Encode(const std::wstring& wstring)
+{
+    std::string ret;
+    ret.reserve(wstring.size());
+    Encode(wstring.data(), static_cast<int>(wstring.size()), ret);
+    return ret;
+}
+
+
+inline void Utf8::Decode(const char* data, const int length, std::wstring& wstring)
+{
+    if (length == 0)
+    {
+        return;
+    }
+
+    // A code point never takes more characters than bytes, so decode straight into the string and shrink it.
+    const auto start = wstring.size();
+    wstring.resize(start + length);
+    wstring.resize(start + Decode(data, length, &wstring[start]));
+}
+
+
+inline std::wstring Utf8::Decode(const char* data, const int length)
+{
+    std::wstring ret;
+    ret.reserve(length);
+    Decode(data, length, ret);
+    return ret;
+}
+
+
+inline int Utf8::Decode(const char* data, const int length, wchar_t* output)
+{
+    auto writing = output;
+
+    auto reading = reinterpret_cast<const unsigned char*>(data);
+    const auto end = reading + length;
+
+    while (reading < end)
+    {
+        if (*reading < 0x80)
+        {
+            const auto widened = Simd::WidenAscii(reading, static_cast<int>(end - reading), writing);
+            reading += widened;
+            writing += widened;
+        }
+        else
+        {
+            writing += WriteCodePoint(DecodeCodePoint(reading, end), writing);
+        }
+    }
+
+    return static_cast<int>(writing - output);
+}
+
+
+inline unsigned int Utf8::DecodeCodePoint(const unsigned char*& data, const unsigned char* end)
+{
+    const auto lead = *data;
+    data++;
+
+    if (lead < 0x80)
+    {
+        return lead;
+    }
+
+    int trailing;
+    unsigned int codePoint;
+    unsigned int minimum;
+
+    if ((lead & 0xE0) == 0xC0)
+    {
+        trailing = 1;
+        codePoint = lead & 0x1F;
+        minimum = 0x80;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        trailing = 2;
+        codePoint = lead & 0x0F;
+        minimum = 0x800;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        trailing = 3;
+        codePoint = lead & 0x07;
+        minimum = 0x10000;
+    }
+    else
+    {
+        return ReplacementCharacter;
+    }
+
+    for (auto i = 0; i < trailing; i++)
+    {
+        if (data == end || (*data & 0xC0) != 0x80)
+        {
+            return ReplacementCharacter;
+        }
+
+        codePoint = (codePoint << 6) | (*data & 0x3F);
+        data++;
+    }
+
+    if (codePoint < minimum || codePoint >= 0x110000 || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+    {
+        return ReplacementCharacter;
+    }
+
+    return codePoint;
+}
+
+
+inline unsigned int Utf8::ReadCodePoint(const wchar_t* data, const int length, int& index)
+{
+    const auto codePoint = static_cast<unsigned int>(data[index]);
+
+    if (codePoint >= 0xD800 && codePoint <= 0xDFFF)
+    {
+        // Only valid when wchar_t is UTF-16 and a high surrogate is followed by a low one.
+        const auto next = index + 1 < length ? static_cast<unsigned int>(data[index + 1]) : 0u;
+        if (sizeof(wchar_t) == 2 && codePoint <= 0xDBFF && next >= 0xDC00 && next <= 0xDFFF)
+        {
+            index++;
+            return 0x10000 + ((codePoint - 0xD800) << 10) + (next - 0xDC00);
+        }
+
+        return ReplacementCharacter;
+    }
+
+    if (codePoint >= 0x110000)
+    {
+        return ReplacementCharacter;
+    }
+
+    return codePoint;
+}
+
+
+inline void Utf8::AppendCodePoint(const unsigned int codePoint, std::wstring& wstring)
+{
+    wchar_t characters[2];
+    wstring.append(characters, WriteCodePoint(codePoint, characters));
+}
+
+
+inline int Utf8::WriteCodePoint(const unsigned int codePoint, wchar_t* output)
+{
+    if (sizeof(wchar_t) == 2 && codePoint >= 0x10000)
+    {
+        output[0] = static_cast<wchar_t>(0xD800 + ((codePoint - 0x10000) >> 10));
+        output[1] = static_cast<wchar_t>(0xDC00 + ((codePoint - 0x10000) & 0x3FF));
+        return 2;
+    }
+
+    output[0] = static_cast<wchar_t>(codePoint);
+    return 1;
+}
+
+
+#endif //DATASTRUCTUREPROJECT_UTF8_HPP
@@ -0,0 +1,469 @@
+//
+// Created on 2026/10/16 at 20:10.
+//
+
+#ifndef DATASTRUCTUREPROJECT_UTF8STRING_HPP
+#define DATASTRUCTUREPROJECT_UTF8STRING_HPP
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include "CharString.hpp"
+#include "CharStringView.hpp"
+#include "StringBuilder.hpp"
+#include "Utf8.hpp"
+
+
+/// \brief A compact string storing its text in UTF-8, for the texts kept for long, e.g. the contents and the words.
+/// \note ASCII takes 1 byte per character and CJK 3 bytes, instead of <code>sizeof(wchar_t)</code> per character.
+/// It hashes and compares the same as a <code>CharString</code> of the same text, so containers keyed by it
+/// can be looked up by <code>CharString</code> and <code>CharStringView</code>.
+/// Unpaired surrogates are stored as U+FFFD.
+class Utf8String
+{
+public:
+    /// \brief Iterates the code points of a <code>Utf8String</code>.
+    class ConstIterator
+    {
+    public:
+        ConstIterator(const unsigned char* position, const unsigned char* end);
+
+        /// \brief Get the code point at the iterator.
+        unsigned int operator*() const;
+
+        ConstIterator& operator++();
+        bool operator==(const ConstIterator& rhs) const;
+        bool operator!=(const ConstIterator& rhs) const;
+
+    private:
+        const unsigned char* _position;
+        const unsigned char* _next;
+        const unsigned char* _end;
+        unsigned int _codePoint = 0;
+
+        void DecodeCurrent();
+    };
+
+    Utf8String() = default;
+    explicit Utf8String(const CharStringView& rhs);
+    explicit Utf8String(const std::wstring& rhs);
+    Utf8String(const Utf8String& rhs);
+    Utf8String(Utf8String&& rhs) noexcept;
+    Utf8String& operator=(const Utf8String& rhs);
+    Utf8String& operator=(Utf8String&& rhs) noexcept;
+    ~Utf8String();
+
+    /// \brief Assign the text of a view to the instance.
+    /// \param rhs The view.
+    void Assign(const CharStringView& rhs);
+
+    /// \brief Translate the instance to a CharString.
+    /// \return The translated CharString.
+    CharString ToCharString() const;
+
+    /// \brief Translate the instance to a std::wstring.
+    /// \return The translated std::wstring.
+    std::wstring ToStdWstring() const;
+
+    /// \brief Decode the instance and append it to a wide string.
+    /// \param wstring The wide string to append to.
+    void AppendTo(std::wstring& wstring) const;
+
+    /// \brief Decode the instance and append it to a builder.
+    /// \param builder The builder to append to.
+    void AppendTo(StringBuilder& builder) const;
+
+    /// \brief Get the UTF-8 bytes.
+    /// \return Pointer to the first byte, nullptr if the instance is empty. It is not null-terminated.
+    const char* GetData() const;
+
+    /// \brief Get the number of UTF-8 bytes.
+    int GetByteLength() const;
+
+    /// \brief Get the number of <code>wchar_t</code> the text takes, as in a <code>CharString</code>.
+    /// \note It walks the text.
+    int GetWideLength() const;
+
+    bool IsEmpty() const;
+
+    /// \brief Get the hash code, the same as a <code>CharString</code> of the same text.
+    /// \note It is computed from the wide characters when assigned, so it is always cached.
+    std::uint64_t GetHashCode() const;
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+    /// \brief Compare the instance with a view, in the order of <code>CharString</code>.
+    /// \param rhs The view.
+    /// \return A negative number if the instance is smaller, 0 if they are equal, otherwise a positive number.
+    int Compare(const CharStringView& rhs) const;
+
+    /// \brief Compare the instance with another one, in the order of <code>CharString</code>.
+    /// \param rhs The other instance.
+    /// \return A negative number if the instance is smaller, 0 if they are equal, otherwise a positive number.
+    int Compare(const Utf8String& rhs) const;
+
+    class Hasher
+    {
+    public:
+        std::uint64_t operator()(const Utf8String& utf8String) const
+        {
+            return utf8String.GetHashCode();
+        }
+
+        std::uint64_t operator()(const CharStringView& charStringView) const
+        {
+            return charStringView.GetHashCode();
+        }
+    };
+
+private:
+    char* _data = nullptr;
+    int _byteLength = 0;
+
+    /// \brief The cached hash code.
+    std::uint64_t _hashCode = CharStringView::ComputeHashCode(nullptr, 0);
+
+    /// \brief Compare two code points in the order of their <code>wchar_t</code>.
+    /// \note It differs from the order of the code points when <code>wchar_t</code> is UTF-16,
+    /// where the surrogates of U+10000 and above sort before U+E000 to U+FFFF.
+    static int CompareCodePoints(unsigned int lhs, unsigned int rhs);
+};
+
+
+bool operator==(const Utf8String& lhs, const Utf8String& rhs);
+bool operator!=(const Utf8String& lhs, const Utf8String& rhs);
+bool operator<(const Utf8String& lhs, const Utf8String& rhs);
+bool operator==(const Utf8String& lhs, const CharStringView& rhs);
+bool operator!=(const Utf8String& lhs, const CharStringView& rhs);
+bool operator<(const Utf8String& lhs, const CharStringView& rhs);
+bool operator<(const CharStringView& lhs, const Utf8String& rhs);
+
+
+inline Utf8String::ConstIterator::ConstIterator(const unsigned char* position, const unsigned char* end)
+    : _position(position), _next(position), _end(end)
+{
+    DecodeCurrent();
+}
+
+
+inline unsigned int Utf8String::ConstIterator::operator*() const
+{
+    return _codePoint;
+}
+
+
+inline Utf8String::ConstIterator& Utf8String::ConstIterator::operator++()
+{
+    _position = _next;
+    DecodeCurrent();
+    return *this;
+}
+
+
+inline bool Utf8String::ConstIterator::operator==(const ConstIterator& rhs) const
+{
+    return _position == rhs._position;
+}
+
+
+inline bool Utf8String::ConstIterator::operator!=(const ConstIterator& rhs) const
+{
+    return _position != rhs._position;
+}
+
+
+inline void Utf8String::ConstIterator::DecodeCurrent()
+{
+    if (_position == _end)
+    {
+        return;
+    }
+
+    if (*_position < 0x80)
+    {
+        _codePoint = *_position;
+        _next = _position + 1;
+    }
+    else
+    {
+        _next = _position;
+        _codePoint = Utf8::DecodeCodePoint(_next, _end);
+    }
+}
+
+
+inline Utf8String::Utf8String(const CharStringView& rhs)
+{
+    Assign(rhs);
+}
+
+
+inline Utf8String::Utf8String(const std::wstring& rhs)
+{
+    Assign(CharStringView(rhs.data(), static_cast<int>(rhs.size())));
+}
+
+
+inline Utf8String::Utf8String(const Utf8String& rhs)
+    : _byteLength(rhs._byteLength), _hashCode(rhs._hashCode)
+{
+    if (_byteLength > 0)
+    {
+        _data = new char[_byteLength];
+        std::memcpy(_data, rhs._data, _byteLength);
+    }
+}
+
+
+inline Utf8String::Utf8String(Utf8String&& rhs) noexcept
+    : _data(rhs._data), _byteLength(rhs._byteLength), _hashCode(rhs._hashCode)
+{
+    rhs._data = nullptr;
+    rhs._byteLength = 0;
+    rhs._hashCode = CharStringView::ComputeHashCode(nullptr, 0);
+}
+
+
+inline Utf8String& Utf8String::operator=(const Utf8String& rhs)
+{
+    if (this != &rhs)
+    {
+        Utf8String copy(rhs);
+        *this = std::move(copy);
+    }
+
+    return *this;
+}
+
+
+inline Utf8String& Utf8String::operator=(Utf8String&& rhs) noexcept
+{
+    std::swap(_data, rhs._data);
+    std::swap(_byteLength, rhs._byteLength);
+    std::swap(_hashCode, rhs._hashCode);
+    return *this;
+}
+
+
+inline Utf8String::~Utf8String()
+{
+    delete[] _data;
+}
+
+
+inline void Utf8String::Assign(const CharStringView& rhs)
+{
+    delete[] _data;
+    _data = nullptr;
+
+    // Measured first, so the bytes are written once into a buffer of the exact size.
+    _byteLength = Utf8::GetEncodedLength(rhs.GetData(), rhs.GetLength());
+    if (_byteLength > 0)
+    {
+        _data = new char[_byteLength];
+        Utf8::Encode(rhs.GetData(), rhs.GetLength(), _data);
+    }
+
+    _hashCode = rhs.GetHashCode();
+}
+
+
+inline CharString Utf8String::ToCharString() const
+{
+    StringBuilder builder(_byteLength);
+    AppendTo(builder);
+    return builder.ToCharString();
+}
+
+
+inline std::wstring Utf8String::ToStdWstring() const
+{
+    return Utf8::Decode(_data, _byteLength);
+}
+
+
+inline void Utf8String::AppendTo(std::wstring& wstring) const
+{
+    Utf8::Decode(_data, _byteLength, wstring);
+}
+
+
+inline void Utf8String::AppendTo(StringBuilder& builder) const
+{
+    // A code point never takes more characters than bytes, the unused room is dropped.
+    const auto start = builder.GetLength();
+    builder.Truncate(start + Utf8::Decode(_data, _byteLength, builder.Expand(_byteLength)));
+}
+
+
+inline const char* Utf8String::GetData() const
+{
+    return _data;
+}
+
+
+inline int Utf8String::GetByteLength() const
+{
+    return _byteLength;
+}
+
+
+inline int Utf8String::GetWideLength() const
+{
+    auto length = 0;
+    for (const auto codePoint : *this)
+    {
+        length += sizeof(wchar_t) == 2 && codePoint >= 0x10000 ? 2 : 1;
+    }
+
+    return length;
+}
+
+
+inline bool Utf8String::IsEmpty() const
+{
+    return _byteLength == 0;
+}
+
+
+inline std::uint64_t Utf8String::GetHashCode() const
+{
+    return _hashCode;
+}
+
+
+inline Utf8String::ConstIterator Utf8String::begin() const
+{
+    const auto data = reinterpret_cast<const unsigned char*>(_data);
+    return ConstIterator(data, data + _byteLength);
+}
+
+
+inline Utf8String::ConstIterator Utf8String::end() const
+{
+    const auto data = reinterpret_cast<const unsigned char*>(_data);
+    return ConstIterator(data + _byteLength, data + _byteLength);
+}
+
+
+inline int Utf8String::Compare(const CharStringView& rhs) const
+{
+    auto iterator = begin();
+    const auto last = end();
+    auto i = 0;
+
+    for (; iterator != last && i < rhs.GetLength(); ++iterator, i++)
+    {
+        const auto comparison = CompareCodePoints(*iterator, Utf8::ReadCodePoint(rhs.GetData(), rhs.GetLength(), i));
+        if (comparison != 0)
+        {
+            return comparison;
+        }
+    }
+
+    return (iterator != last) - (i < rhs.GetLength());
+}
+
+
+inline int Utf8String::Compare(const Utf8String& rhs) const
+{
+    const auto lhsData = reinterpret_cast<const unsigned char*>(_data);
+    const auto rhsData = reinterpret_cast<const unsigned char*>(rhs._data);
+    const auto minLength = std::min(_byteLength, rhs._byteLength);
+
+    auto mismatch = 0;
+    while (mismatch < minLength && lhsData[mismatch] == rhsData[mismatch])
+    {
+        mismatch++;
+    }
+
+    if (mismatch == minLength)
+    {
+        return (_byteLength > minLength) - (rhs._byteLength > minLength);
+    }
+
+    // Go back to the start of the code point and compare the differing code points.
+    while (mismatch > 0 && (lhsData[mismatch] & 0xC0) == 0x80)
+    {
+        mismatch--;
+    }
+
+    auto lhsReading = lhsData + mismatch;
+    auto rhsReading = rhsData + mismatch;
+    return CompareCodePoints(Utf8::DecodeCodePoint(lhsReading, lhsData + _byteLength),
+                             Utf8::DecodeCodePoint(rhsReading, rhsData + rhs._byteLength));
+}
+
+
+inline int Utf8String::CompareCodePoints(const unsigned int lhs, const unsigned int rhs)
+{
+    if (lhs == rhs)
+    {
+        return 0;
+    }
+
+    // Compare the first wchar_t, the high surrogates when both need two.
+    auto lhsKey = lhs;
+    auto rhsKey = rhs;
+    if (sizeof(wchar_t) == 2)
+    {
+        lhsKey = lhs < 0x10000 ? lhs : 0xD800 + ((lhs - 0x10000) >> 10);
+        rhsKey = rhs < 0x10000 ? rhs : 0xD800 + ((rhs - 0x10000) >> 10);
+        if (lhsKey == rhsKey)
+        {
+            lhsKey = lhs;
+            rhsKey = rhs;
+        }
+    }
+
+    return lhsKey < rhsKey ? -1 : 1;
+}
+
+
+inline bool operator==(const Utf8String& lhs, const Utf8String& rhs)
+{
+    return lhs.GetByteLength() == rhs.GetByteLength() && lhs.GetHashCode() == rhs.GetHashCode() &&
+        (lhs.IsEmpty() || std::memcmp(lhs.GetData(), rhs.GetData(), lhs.GetByteLength()) == 0);
+}
+
+
+inline bool operator!=(const Utf8String& lhs, const Utf8String& rhs)
+{
+    return !(lhs == rhs);
+}
+
+
+inline bool operator<(const Utf8String& lhs, const Utf8String& rhs)
+{
+    return lhs.Compare(rhs) < 0;
+}
+
+
+inline bool operator==(const Utf8String& lhs, const CharStringView& rhs)
+{
+    return lhs.Compare(rhs) == 0;
+}
+
+
+inline bool operator!=(const Utf8String& lhs, const CharStringView& rhs)
+{
+    return lhs.Compare(rhs) != 0;
+}
+
+
+inline bool operator<(const Utf8String& lhs, const CharStringView& rhs)
+{
+    return lhs.Compare(rhs) < 0;
+}
+
+
+inline bool operator<(const CharStringView& lhs, const Utf8String& rhs)
+{
+    return rhs.Compare(lhs) > 0;
+}
+
+
+#endif //DATASTRUCTUREPROJECT_UTF8STRING_HPP
@@ -0,0 +1,179 @@
+//
+// Created on 2026/10/16 at 22:50.
+//
+
+#ifndef DATASTRUCTUREPROJECT_XMLDOCUMENT_HPP
+#define DATASTRUCTUREPROJECT_XMLDOCUMENT_HPP
+
+#include <utility>
+#include <vector>
+#include "CharString.hpp"
+#include "CharStringView.hpp"
+#include "HtmlTokenizer.hpp"
+#include "XmlNode.hpp"
+#include "XmlNodeIndex.hpp"
+
+
+/// \brief The xml tree of a xml/html file, with all its nodes in one array.
+/// \note The document owns the file, the nodes view their names, texts and attributes in it.
+/// The nodes are in document order and link to their next siblings by distance, the attributes of all the
+/// nodes are in another array. Deleting the document frees the whole tree at once.
+class XmlDocument
+{
+public:
+    /// \brief Build the tree of a file.
+    /// \param xml Content of the xml/html. Move it in to keep the document from copying it.
+    /// \param index The index to add the elements to, it can be nullptr. It is invalid after the document is deleted.
+    explicit XmlDocument(CharString xml, XmlNodeIndex* index = nullptr);
+
+    XmlDocument(const XmlDocument&) = delete;
+    XmlDocument& operator=(const XmlDocument&) = delete;
+
+    /// \brief Get the pseudo root of the tree, it is not indexed.
+    XmlNode* GetRoot();
+
+    /// \brief Get the number of nodes, the pseudo root included.
+    int GetNodeCount() const;
+
+    /// \brief Get the file the nodes view into.
+    const CharString& GetSource() const;
+
+private:
+    CharString _source;
+    std::vector<XmlNode> _nodes;
+    std::vector<CharStringView> _attributes;
+
+    /// \brief Append a node as the last child of a node.
+    /// \param parent Index of the parent.
+    /// \param lastChild Index of the last child of the parent so far, -1 if none. It is set to the new node.
+    /// \return Index of the new node.
+    int AppendNode(int parent, int& lastChild, const CharStringView& nameOrContent);
+
+    /// \brief Handler of <code>HtmlTokenizer</code> appending the nodes in document order.
+    class Builder
+    {
+    public:
+        explicit Builder(XmlDocument& document);
+
+        void OnStartElement(const CharStringView& name, const std::vector<CharStringView>& attributes);
+        void OnEndElement(const CharStringView& name);
+        void OnText(const CharStringView& text);
+        void OnComment(const CharStringView& comment);
+
+    private:
+        XmlDocument& _document;
+
+        /// \brief Indexes of the open elements, the root is at the front and never popped.
+        std::vector<int> _openElements;
+
+        /// \brief Index of the last child of each open element, -1 if none.
+        std::vector<int> _lastChildren;
+    };
+};
+
+
+inline XmlDocument::XmlDocument(CharString xml, XmlNodeIndex* index)
+    : _source(std::move(xml))
+{
+    _nodes.emplace_back();
+
+    Builder builder(*this);
+    HtmlTokenizer::Tokenize(_source, builder);
+
+    _nodes.front()._subtreeSize = static_cast<int>(_nodes.size());
+
+    // The arrays are complete, the nodes can point into them now.
+    for (auto i = 0; i < static_cast<int>(_nodes.size()); i++)
+    {
+        auto& node = _nodes[i];
+        node._attributes = _attributes.data() + node._firstAttribute;
+
+        if (index != nullptr && i != 0 && !node.IsTextNode && !node.IsCommentNode)
+        {
+            index->Add(&node);
+        }
+    }
+}
+
+
+inline XmlNode* XmlDocument::GetRoot()
+{
+    return &_nodes.front();
+}
+
+
+inline int XmlDocument::GetNodeCount() const
+{
+    return static_cast<int>(_nodes.size());
+}
+
+
+inline const CharString& XmlDocument::GetSource() const
+{
+    return _source;
+}
+
+
+inline int XmlDocument::AppendNode(const int parent, int& lastChild, const CharStringView& nameOrContent)
+{
+    const auto node = static_cast<int>(_nodes.size());
+    _nodes.emplace_back();
+    _nodes.back().NameOrContent = nameOrContent;
+
+    _nodes[parent]._childCount++;
+    if (lastChild != -1)
+    {
+        _nodes[lastChild]._nextSibling = node - lastChild;
+    }
+    lastChild = node;
+
+    return node;
+}
+
+
+inline XmlDocument::Builder::Builder(XmlDocument& document)
+    : _document(document), _openElements(1, 0), _lastChildren(1, -1)
+{
+}
+
+
+inline void XmlDocument::Builder::OnStartElement(const CharStringView& name,
+                                                 const std::vector<CharStringView>& attributes)
+{
+    const auto element = _document.AppendNode(_openElements.back(), _lastChildren.back(), name);
+
+    auto& node = _document._nodes[element];
+    node._firstAttribute = static_cast<int>(_document._attributes.size());
+    node._attributeCount = static_cast<int>(attributes.size());
+    _document._attributes.insert(_document._attributes.end(), attributes.begin(), attributes.end());
+
+    _openElements.push_back(element);
+    _lastChildren.push_back(-1);
+}
+
+
+inline void XmlDocument::Builder::OnEndElement(const CharStringView&)
+{
+    const auto element = _openElements.back();
+    _document._nodes[element]._subtreeSize = static_cast<int>(_document._nodes.size()) - element;
+
+    _openElements.pop_back();
+    _lastChildren.pop_back();
+}
+
+
+inline void XmlDocument::Builder::OnText(const CharStringView& text)
+{
+    const auto node = _document.AppendNode(_openElements.back(), _lastChildren.back(), text);
+    _document._nodes[node].IsTextNode = true;
+}
+
+
+inline void XmlDocument::Builder::OnComment(const CharStringView& comment)
+{
+    const auto node = _document.AppendNode(_openElements.back(), _lastChildren.back(), comment);
+    _document._nodes[node].IsCommentNode = true;
+}
+
+
+#endif //DATASTRUCTUREPROJECT_XMLDOCUMENT_HPP
@@ -5,23 +5,22 @@
 #ifndef DATASTRUCTUREPROJECT_XMLNODE_HPP
 #define DATASTRUCTUREPROJECT_XMLNODE_HPP
 
-#include "LinkedList.hpp"
+#include <stdexcept>
 #include "CharString.hpp"
+#include "CharStringView.hpp"
 
 
 /// \brief A class representing a node in a xml/html file.
+/// \note The nodes of a file are stored in document order in one array owned by an <code>XmlDocument</code>,
+/// so the first child of a node is right after it and its whole subtree is the nodes following it.
+/// The names, texts and attributes are views into the file kept by the document.
 class XmlNode
 {
+    friend class XmlDocument;
 public:
     /// \brief If the node is a comment or a text, this field is the content of it.<br>
     /// Else this field is the name of the tag.
-    CharString NameOrContent;
-
-    /// \brief The list of all the attributes of the instance if the instance is a tag.
-    LinkedList<CharString> Attributes;
-
-    /// \brief The list of all the children nodes of the instance if the instance is a tag.
-    LinkedList<XmlNode *> Children;
+    CharStringView NameOrContent;
 
     /// \brief Whether the node is a comment.
     bool IsCommentNode = false;
@@ -29,14 +28,120 @@ public:
     /// \brief Whether the node is a text.
     bool IsTextNode = false;
 
-    ~XmlNode()
+    /// \brief Get the first child of the node.
+    /// \return The child, nullptr if there is none.
+    XmlNode* GetFirstChild();
+
+    /// \brief Get the next child of the parent of the node.
+    /// \return The sibling, nullptr if there is none.
+    XmlNode* GetNextSibling();
+
+    /// \brief Get a child of the node.
+    /// \param index Index of the child, starting from 0.
+    /// \return The child, nullptr if there are not so many.
+    XmlNode* GetChildAt(int index);
+
+    int GetChildCount() const;
+
+    /// \brief Get the number of nodes in the subtree of the node, the node itself included.
+    int GetSubtreeSize() const;
+
+    int GetAttributeCount() const;
+
+    /// \brief Get an attribute as written in the tag, e.g. <code>class="t_f"</code>.
+    /// \throw std::out_of_range if the index is invalid.
+    const CharStringView& GetAttributeAt(int index) const;
+
+    /// \brief Test if the node has an attribute.
+    /// \param attribute The attribute as written in the tag.
+    bool HasAttribute(const CharStringView& attribute) const;
+
+private:
+    /// \brief The distance to the next sibling in the array, 0 if there is none.
+    int _nextSibling = 0;
+
+    int _subtreeSize = 1;
+    int _childCount = 0;
+
+    /// \brief The attributes are <code>_attributes[0, _attributeCount)</code>, in the array of the document.
+    const CharStringView* _attributes = nullptr;
+    int _attributeCount = 0;
+
+    /// \brief Index of the first attribute in the array of the document, until <code>_attributes</code> is set.
+    int _firstAttribute = 0;
+};
+
+
+inline XmlNode* XmlNode::GetFirstChild()
+{
+    return _childCount != 0 ? this + 1 : nullptr;
+}
+
+
+inline XmlNode* XmlNode::GetNextSibling()
+{
+    return _nextSibling != 0 ? this + _nextSibling : nullptr;
+}
+
+
+inline XmlNode* XmlNode::GetChildAt(const int index)
+{
+    if (index < 0 || index >= _childCount)
     {
-        for(auto i:Children)
+        return nullptr;
+    }
+
+    auto child = GetFirstChild();
+    for (auto i = 0; i < index; i++)
+    {
+        child = child->GetNextSibling();
+    }
+
+    return child;
+}
+
+
+inline int XmlNode::GetChildCount() const
+{
+    return _childCount;
+}
+
+
+inline int XmlNode::GetSubtreeSize() const
+{
+    return _subtreeSize;
+}
+
+
+inline int XmlNode::GetAttributeCount() const
+{
+    return _attributeCount;
+}
+
+
+inline const CharStringView& XmlNode::GetAttributeAt(const int index) const
+{
+    if (index < 0 || index >= _attributeCount)
+    {
+        throw std::out_of_range("Index out of range in XmlNode::GetAttributeAt()");
+    }
+
+    return _attributes[index];
+}
+
+
+inline bool XmlNode::HasAttribute(const CharStringView& attribute) const
+{
+    for (auto i = 0; i < _attributeCount; i++)
+    {
+        if (_attributes[i] == attribute)
         {
-            delete i;
+            return true;
         }
     }
-};
+
+    return false;
+}
 
 
 #endif //DATASTRUCTUREPROJECT_XMLNODE_HPP
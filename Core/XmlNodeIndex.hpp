@@ -0,0 +1,133 @@
+//
+// Created on 2026/10/16 at 22:10.
+//
+
+#ifndef DATASTRUCTUREPROJECT_XMLNODEINDEX_HPP
+#define DATASTRUCTUREPROJECT_XMLNODEINDEX_HPP
+
+#include <vector>
+#include "XmlNode.hpp"
+#include "CharString.hpp"
+#include "CharStringView.hpp"
+#include "FlatHashMap.hpp"
+
+
+/// \brief The elements of a xml tree grouped by their attributes and by their names, each group in document order.
+/// \note Filled by <code>XmlParser::ParseXml</code> once the tree is built. It points into the tree,
+/// so it must not be used after the tree is deleted.
+class XmlNodeIndex
+{
+public:
+    /// \brief Add an element by its name and by each of its attributes, call it in document order.
+    /// \param element The element.
+    void Add(XmlNode* element);
+
+    /// \brief Get all the elements with an attribute.
+    /// \param attribution The attribute as written in the tag.
+    /// \return The elements in document order, empty if there is none.
+    /// \note The list is invalidated when an element is added.
+    const std::vector<XmlNode *>& GetElementsByAttribution(const CharStringView& attribution);
+
+    /// \brief Get an element with an attribute.
+    /// \param attribution The attribute as written in the tag.
+    /// \param occurrence Which of the elements in document order, starting from 0.
+    /// \return The element, nullptr if there are not so many.
+    XmlNode* GetElementByAttribution(const CharStringView& attribution, int occurrence = 0);
+
+    /// \brief Get all the elements with a name.
+    /// \param name Name of the elements.
+    /// \return The elements in document order, empty if there is none.
+    /// \note The list is invalidated when an element is added.
+    const std::vector<XmlNode *>& GetElementsByName(const CharStringView& name);
+
+    /// \brief Get an element with a name.
+    /// \param name Name of the elements.
+    /// \param occurrence Which of the elements in document order, starting from 0.
+    /// \return The element, nullptr if there are not so many.
+    XmlNode* GetElementByName(const CharStringView& name, int occurrence = 0);
+
+private:
+    using NodeMap = FlatHashMap<CharString, std::vector<XmlNode *>, CharString::Hasher>;
+
+    NodeMap _byAttribution;
+    NodeMap _byName;
+
+    /// \brief Append an element to the list of a key.
+    static void Append(NodeMap& map, const CharStringView& key, XmlNode* element);
+
+    /// \brief Get the list of a key, an empty one if the key is not in the map.
+    static const std::vector<XmlNode *>& Get(NodeMap& map, const CharStringView& key);
+
+    /// \brief Get an element from the list of a key.
+    static XmlNode* Get(NodeMap& map, const CharStringView& key, int occurrence);
+};
+
+
+inline void XmlNodeIndex::Add(XmlNode* element)
+{
+    Append(_byName, element->NameOrContent, element);
+    for (auto i = 0; i < element->GetAttributeCount(); i++)
+    {
+        Append(_byAttribution, element->GetAttributeAt(i), element);
+    }
+}
+
+
+inline const std::vector<XmlNode *>& XmlNodeIndex::GetElementsByAttribution(const CharStringView& attribution)
+{
+    return Get(_byAttribution, attribution);
+}
+
+
+inline XmlNode* XmlNodeIndex::GetElementByAttribution(const CharStringView& attribution, const int occurrence)
+{
+    return Get(_byAttribution, attribution, occurrence);
+}
+
+
+inline const std::vector<XmlNode *>& XmlNodeIndex::GetElementsByName(const CharStringView& name)
+{
+    return Get(_byName, name);
+}
+
+
+inline XmlNode* XmlNodeIndex::GetElementByName(const CharStringView& name, const int occurrence)
+{
+    return Get(_byName, name, occurrence);
+}
+
+
+inline void XmlNodeIndex::Append(NodeMap& map, const CharStringView& key, XmlNode* element)
+{
+    auto iterator = map.Locate(key);
+    if (iterator != map.EmptyIterator())
+    {
+        // An element with the same attribute twice is listed once.
+        if (iterator->empty() || iterator->back() != element)
+        {
+            iterator->push_back(element);
+        }
+        return;
+    }
+
+    map.Insert(CharString(key), std::vector<XmlNode *>(1, element));
+}
+
+
+inline const std::vector<XmlNode *>& XmlNodeIndex::Get(NodeMap& map, const CharStringView& key)
+{
+    static const std::vector<XmlNode *> none;
+
+    auto iterator = map.Locate(key);
+    return iterator != map.EmptyIterator() ? *iterator : none;
+}
+
+
+inline XmlNode* XmlNodeIndex::Get(NodeMap& map, const CharStringView& key, const int occurrence)
+{
+    const auto& elements = Get(map, key);
+    return occurrence >= 0 && occurrence < static_cast<int>(elements.size()) ? elements[occurrence] : nullptr;
+}
+
+
+#endif //DATASTRUCTUREPROJECT_XMLNODEINDEX_HPP
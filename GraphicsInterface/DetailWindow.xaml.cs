@@ -12,7 +12,7 @@ namespace GraphicsInterface
             var inlines = ContentBox.Inlines;
 
             inlines.Clear();
-            var stringList = mainWindow.InputBox.Text.Split(new[] {' '}, StringSplitOptions.RemoveEmptyEntries);
+            var query = mainWindow.InputBox.Text;
 
             // Add Information.
             inlines.Add(new Run($"ID of this document : {documentId}"));
@@ -21,12 +21,14 @@ namespace GraphicsInterface
             inlines.Add(new LineBreak());
             inlines.Add(new LineBreak());
 
-            inlines.Add(MainWindow.GetFormattedString(mainWindow.Core.GetPostTitle(documentId), stringList));
+            var title = mainWindow.Core.GetPostTitle(documentId);
+            inlines.Add(MainWindow.GetFormattedString(title, mainWindow.Core.Highlight(title, query)));
 
             inlines.Add(new LineBreak());
             inlines.Add(new LineBreak());
 
-            inlines.Add(MainWindow.GetFormattedString(mainWindow.Core.GetPostContent(documentId), stringList));
+            var content = mainWindow.Core.GetPostContent(documentId);
+            inlines.Add(MainWindow.GetFormattedString(content, mainWindow.Core.Highlight(content, query)));
         }
     }
 }
\ No newline at end of file
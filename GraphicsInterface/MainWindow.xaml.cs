@@ -12,6 +12,8 @@ namespace GraphicsInterface
     {
         public readonly GuiCore Core = new GuiCore();
 
+        private const int SnippetWidth = 80;
+
         public MainWindow()
         {
             InitializeComponent();
@@ -89,8 +91,11 @@ namespace GraphicsInterface
 
                 ResultDisplay.Inlines.Add(button);
                 ResultDisplay.Inlines.Add(new LineBreak());
-                var stringList = InputBox.Text.Split(new[] {' '}, StringSplitOptions.RemoveEmptyEntries);
-                ResultDisplay.Inlines.Add(GetFormattedString(Core.GetPostTitle(documentId), stringList));
+                var title = Core.GetPostTitle(documentId);
+                ResultDisplay.Inlines.Add(GetFormattedString(title, Core.Highlight(title, InputBox.Text)));
+                ResultDisplay.Inlines.Add(new LineBreak());
+                var snippet = Core.GetSnippet(Core.GetPostContent(documentId), InputBox.Text, SnippetWidth);
+                ResultDisplay.Inlines.Add(GetFormattedString(snippet, Core.Highlight(snippet, InputBox.Text)));
                 ResultDisplay.Inlines.Add(new LineBreak());
                 ResultDisplay.Inlines.Add(new LineBreak());
             }
@@ -98,76 +103,30 @@ namespace GraphicsInterface
             QueryButton.IsEnabled = true;
         }
 
-        public static Inline GetFormattedString(string targetString, string[] stringList)
+        public static Inline GetFormattedString(string targetString,
+            IEnumerable<KeyValuePair<int, int>> highlights)
         {
-            var hightlightList = new Dictionary<int, int>();
-
-            if (targetString == "")
-                return new Span();
-
-            foreach (var word in stringList)
-            {
-                var indexes = AllIndexesOf(targetString, word);
-                foreach (var index in indexes)
-                    hightlightList.Add(index, word.Length);
-            }
-
-            var isHighlighted = new bool[targetString.Length];
-            for (var i = 0; i < isHighlighted.Length; i++)
-                isHighlighted[i] = false;
-
-            foreach (var key in hightlightList.Keys)
-                for (var i = key; i < key + hightlightList[key]; i++)
-                    isHighlighted[i] = true;
-
             var ret = new Span();
 
+            // The highlights are sorted and do not overlap, the text between them is not highlighted.
             var lastIndex = 0;
-            var renderingIndex = 0;
-            var isHighlighting = isHighlighted[0];
+            foreach (var highlight in highlights)
+            {
+                if (highlight.Key > lastIndex)
+                    ret.Inlines.Add(new Run(targetString.Substring(lastIndex, highlight.Key - lastIndex)));
 
-            while (renderingIndex < targetString.Length)
-                if (isHighlighting == isHighlighted[renderingIndex])
+                ret.Inlines.Add(new Bold(new Run(targetString.Substring(highlight.Key, highlight.Value))
                 {
-                    renderingIndex++;
-                }
-                else
-                {
-                    if (isHighlighting)
-                        ret.Inlines.Add(new Bold(
-                            new Run(targetString.Substring(lastIndex, renderingIndex - lastIndex))
-                            {
-                                Background = Brushes.DarkOrange
-                            }));
-                    else
-                        ret.Inlines.Add(new Run(targetString.Substring(lastIndex, renderingIndex - lastIndex)));
-
-                    isHighlighting = !isHighlighting;
-                    lastIndex = renderingIndex;
-                }
-
-            if (isHighlighting)
-                ret.Inlines.Add(new Bold(
-                    new Run(targetString.Substring(lastIndex, renderingIndex - lastIndex))
-                    {
-                        Background = Brushes.DarkOrange
-                    }));
-            else
-                ret.Inlines.Add(new Run(targetString.Substring(lastIndex, renderingIndex - lastIndex)));
-
-            return ret;
-        }
+                    Background = Brushes.DarkOrange
+                }));
 
-        private static IEnumerable<int> AllIndexesOf(string source, string target)
-        {
-            var indexes = new List<int>();
-            for (var index = 0;; index += target.Length)
-            {
-                index = source.IndexOf(target, index, StringComparison.Ordinal);
-                if (index == -1)
-                    return indexes;
-                indexes.Add(index);
+                lastIndex = highlight.Key + highlight.Value;
             }
+
+            if (lastIndex < targetString.Length)
+                ret.Inlines.Add(new Run(targetString.Substring(lastIndex)));
+
+            return ret;
         }
     }
 }
\ No newline at end of file
@@ -11,44 +11,38 @@ namespace Utilities
 {
     public class Utilities
     {
-        public static string GetHtmlByUrl(string url)
+        public static byte[] DownloadHtml(string url, out string charset)
         {
-            var client = new WebClient {Encoding = Encoding.UTF8};
+            var client = new WebClient();
 
             var data = client.DownloadData(url);
             var contentType = client.ResponseHeaders["Content-Type"];
 
-            string encoding = null;
+            charset = null;
 
-            var contentTypeSlices = contentType.Split(new[] {';', ' '}, StringSplitOptions.RemoveEmptyEntries);
-            foreach (var contentTypeSlice in contentTypeSlices)
+            if (contentType != null)
             {
-                var slices = contentTypeSlice.Split(new[] {'=', ' '}, StringSplitOptions.RemoveEmptyEntries);
-                if (slices[0] == "charset")
+                var contentTypeSlices = contentType.Split(new[] {';', ' '}, StringSplitOptions.RemoveEmptyEntries);
+                foreach (var contentTypeSlice in contentTypeSlices)
                 {
-                    encoding = slices[1];
-                    break;
+                    var slices = contentTypeSlice.Split(new[] {'=', ' '}, StringSplitOptions.RemoveEmptyEntries);
+                    if (slices.Length == 2 && slices[0] == "charset")
+                    {
+                        charset = slices[1].Trim('"');
+                        break;
+                    }
                 }
             }
 
-            if (encoding == null)
-                encoding = "UTF-8";
-
-            var webEncoding = Encoding.GetEncoding(encoding);
             client.Dispose();
-            return webEncoding.GetString(data);
-        }
-
-        public static string GetDecodedHtml(string encodedHtml)
-        {
-            return WebUtility.HtmlDecode(encodedHtml);
+            return data;
         }
 
         public static void SaveWordCloud(string csvFilePath, string savingFilePath)
         {
             var wordsAndFreqs = new List<Tuple<string, int>>();
 
-            using (var streamReader = new StreamReader(csvFilePath, Encoding.GetEncoding("gb2312")))
+            using (var streamReader = new StreamReader(csvFilePath, Encoding.UTF8))
             {
                 string reading;
                 while ((reading = streamReader.ReadLine()) != null)